@@ -1,11 +1,75 @@
 // Copyright Chun Shen @ 2018
 
+#include <cstring>
+
 #include "util.h"
 #include "HydroinfoMUSIC.h"
+#include "doctest.h"
+
+namespace {
+
+//! converts a float to IEEE half precision, rounding to the nearest even
+uint16_t float_to_half(const float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t abs_bits = bits & 0x7fffffffu;
+    if (abs_bits > 0x7f800000u) return(sign | 0x7e00u);      // nan
+    if (abs_bits >= 0x477ff000u) return(sign | 0x7c00u);     // >= 65520
+    if (abs_bits < 0x38800000u) {
+        // below 2^-14 the half is subnormal, below 2^-25 it is zero
+        if (abs_bits < 0x33000000u) return(sign);
+        const int shift = 126 - static_cast<int>(abs_bits >> 23);
+        const uint32_t mantissa = (abs_bits & 0x7fffffu) | 0x800000u;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            half++;
+        }
+        return(static_cast<uint16_t>(sign | half));
+    }
+    uint32_t half = (abs_bits - 0x38000000u) >> 13;
+    const uint32_t remainder = abs_bits & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        half++;
+    }
+    return(static_cast<uint16_t>(sign | half));
+}
+
+
+float half_to_float(const uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1fu;
+    const uint32_t mantissa = half & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0) {
+        const float value = mantissa*5.9604644775390625e-8f;  // 2^-24
+        return((half & 0x8000u) ? -value : value);
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return(value);
+}
+
+inline float load_value(const float value) {return(value);}
+inline float load_value(const uint16_t value) {return(half_to_float(value));}
+
+}  // namespace
+
 
 HydroinfoMUSIC::HydroinfoMUSIC() {
     hydroTauMax = 0.0;
     itaumax = 0;
+    ixmax = 0;
+    iymax = 0;
+    ietamax = 0;
+    store_precision = 4;
+    cells_per_slice = 0;
 }
 
 HydroinfoMUSIC::~HydroinfoMUSIC() {
@@ -13,7 +77,8 @@ HydroinfoMUSIC::~HydroinfoMUSIC() {
 }
 
 void HydroinfoMUSIC::clean_hydro_event() {
-    lattice_ideal.clear();
+    slices_float.clear();
+    slices_half.clear();
     hydroTauMax = 0.;
     itaumax = 0;
 }
@@ -21,6 +86,66 @@ void HydroinfoMUSIC::clean_hydro_event() {
 void HydroinfoMUSIC::getHydroValues(
         const double x, const double y, const double z, const double t,
         fluidCell* info) {
+    GridPosition pos;
+    const int status = interpolate_fluid_cell(x, y, z, t, pos, info);
+    if (status == 0) return;
+
+    if (status == 1) {
+        music_message << "[HydroinfoMUSIC::getHydroValues]: "
+                      << "WARNING - x out of range x=" << x
+                      << ", ix=" << pos.ix << ", ixmax=" << ixmax;
+        music_message.flush("warning");
+    } else if (status == 2) {
+        music_message << "[HydroinfoMUSIC::getHydroValues]: "
+                      << "WARNING - y out of range, y=" << y
+                      << ", iy=" << pos.iy << ", iymax=" << iymax;
+        music_message.flush("warning");
+    } else if (status == 3) {
+        music_message << "[HydroinfoMUSIC::getHydroValues]: WARNING - "
+                      << "tau out of range, itau=" << pos.itau
+                      << ", itaumax=" << itaumax;
+        music_message.flush("warning");
+        music_message << "[HydroinfoMUSIC::getHydroValues]: tau= " << pos.tau
+                      << ", hydroTau0 = " << hydroTau0
+                      << ", hydroTauMax = " << hydroTauMax
+                      << ", hydroDtau = " << hydroDtau;
+        music_message.flush("warning");
+        return;
+    } else {
+        music_message << "[HydroinfoMUSIC::getHydroValues]: WARNING - "
+                      << "eta out of range, ieta=" << pos.ieta
+                      << ", ietamax=" << ietamax;
+        music_message.flush("warning");
+        return;
+    }
+    music_message << "x=" << x << " y=" << y << " eta=" << pos.eta
+                  << " ix=" << pos.ix << " iy=" << pos.iy
+                  << " ieta=" << pos.ieta;
+    music_message.flush("warning");
+    music_message << "t=" << t << " tau=" << pos.tau
+                  << " itau=" << pos.itau << " itaumax=" << itaumax;
+    music_message.flush("warning");
+}
+
+
+int HydroinfoMUSIC::getHydroValues(
+        const int n, const double *x, const double *y, const double *z,
+        const double *t, fluidCell *info) const {
+    int n_outside = 0;
+    GridPosition pos;
+    for (int i = 0; i < n; i++) {
+        if (interpolate_fluid_cell(x[i], y[i], z[i], t[i], pos,
+                                   &info[i]) != 0) {
+            n_outside++;
+        }
+    }
+    return(n_outside);
+}
+
+
+int HydroinfoMUSIC::locate_point(
+        const double x, const double y, const double z, const double t,
+        GridPosition &pos) const {
 // For interpolation of evolution files in tau-eta coordinates. Only the
 // reading of MUSIC's evolution_xyeta.dat file is implemented here.
 // For simplicity, hydro_eta_max refers to MUSIC's eta_size, and similarly for
@@ -41,207 +166,99 @@ void HydroinfoMUSIC::getHydroValues(
         tau = t;
         eta = z;
     }
+    pos.tau = tau;
+    pos.eta = eta;
 
-    int ieta = static_cast<int>((hydro_eta_max + eta)/hydroDeta + 0.0001);
+    pos.ieta = static_cast<int>((hydro_eta_max + eta)/hydroDeta + 0.0001);
     if (boost_invariant == 1) {
-        ieta = 0;
+        pos.ieta = 0;
     }
 
-    const int itau = static_cast<int>((tau - hydroTau0)/hydroDtau + 0.0001);
-    const int ix   = static_cast<int>((hydroXmax + x)/hydroDx + 0.0001);
-    const int iy   = static_cast<int>((hydroXmax + y)/hydroDx + 0.0001);
-
-    double xfrac = (x - (static_cast<double>(ix)*hydroDx - hydroXmax))/hydroDx;
-    double yfrac = (y - (static_cast<double>(iy)*hydroDx - hydroXmax))/hydroDx;
-    double etafrac = (eta/hydroDeta - static_cast<double>(ieta)
-                      + 0.5*static_cast<double>(ietamax));
-    double taufrac = (tau - hydroTau0)/hydroDtau - static_cast<double>(itau);
-
-    if (ix < 0 || ix >= ixmax) {
-        music_message << "[HydroinfoMUSIC::getHydroValues]: "
-                      << "WARNING - x out of range x=" << x
-                      << ", ix=" << ix << ", ixmax=" << ixmax;
-        music_message.flush("warning");
-        music_message << "x=" << x << " y=" << y << " eta=" << eta
-                      << " ix=" << ix << " iy=" << iy << " ieta=" << ieta;
-        music_message.flush("warning");
-        music_message << "t=" << t << " tau=" << tau
-                      << " itau=" << itau << " itaumax=" << itaumax;
-        music_message.flush("warning");
-        music_message.flush("warning");
-
-        info->temperature = 0.0;
-        info->ed = 0.0;
-        info->sd = 0.0;
-        info->pressure = 0.0;
-        info->vx = 0.0;
-        info->vy = 0.0;
-        info->vz = 0.0;
-        return;
-    }
+    pos.itau = static_cast<int>((tau - hydroTau0)/hydroDtau + 0.0001);
+    pos.ix   = static_cast<int>((hydroXmax + x)/hydroDx + 0.0001);
+    pos.iy   = static_cast<int>((hydroXmax + y)/hydroDy + 0.0001);
+
+    pos.xfrac = (x - (static_cast<double>(pos.ix)*hydroDx - hydroXmax))
+                /hydroDx;
+    pos.yfrac = (y - (static_cast<double>(pos.iy)*hydroDy - hydroXmax))
+                /hydroDy;
+    pos.etafrac = (eta/hydroDeta - static_cast<double>(pos.ieta)
+                   + 0.5*static_cast<double>(ietamax));
+    pos.taufrac = ((tau - hydroTau0)/hydroDtau
+                   - static_cast<double>(pos.itau));
+
+    if (pos.ix < 0 || pos.ix >= ixmax) return(1);
+    if (pos.iy < 0 || pos.iy >= iymax) return(2);
+    // the last stored slice has no successor, later times are outside
+    if (pos.itau < 0 || pos.itau >= itaumax) return(3);
+    if (pos.ieta < 0 || pos.ieta >= ietamax) return(4);
+    return(0);
+}
 
-    if (iy < 0 || iy >= ixmax) {
-        music_message << "[HydroinfoMUSIC::getHydroValues]: "
-                      << "WARNING - y out of range, y=" << y << ", iy="  << iy
-                      << ", iymax=" << ixmax;
-        music_message.flush("warning");
-        music_message << "x=" << x << " y=" << y << " eta=" << eta
-                      << " ix=" << ix << " iy=" << iy << " ieta=" << ieta;
-        music_message.flush("warning");
-        music_message << "t=" << t << " tau=" << tau
-                      << " itau=" << itau << " itaumax=" << itaumax;
-        music_message.flush("warning");
-        music_message.flush("warning");
 
-        info->temperature = 0.0;
-        info->ed = 0.0;
-        info->sd = 0.0;
-        info->pressure = 0.0;
-        info->vx = 0.0;
-        info->vy = 0.0;
-        info->vz = 0.0;
-        return;
-    }
-    if (itau < 0 || itau > itaumax) {
-        music_message << "[HydroinfoMUSIC::getHydroValues]: WARNING - "
-                      << "tau out of range, itau=" << itau
-                      << ", itaumax=" << itaumax;
-        music_message.flush("warning");
-        music_message << "[HydroinfoMUSIC::getHydroValues]: tau= " << tau
-                      << ", hydroTau0 = " << hydroTau0
-                      << ", hydroTauMax = " << hydroTauMax
-                      << ", hydroDtau = " << hydroDtau;
-        music_message.flush("warning");
-
-        info->temperature = 0.0;
-        info->ed = 0.0;
-        info->sd = 0.0;
-        info->pressure = 0.0;
-        info->vx = 0.0;
-        info->vy = 0.0;
-        info->vz = 0.0;
-        return;
+int HydroinfoMUSIC::interpolate_fluid_cell(
+        const double x, const double y, const double z, const double t,
+        GridPosition &pos, fluidCell *info) const {
+    const int status = locate_point(x, y, z, t, pos);
+    if (status != 0) {
+        std::memset(info, 0, sizeof(fluidCell));
+        return(status);
     }
-    if (ieta < 0 || ieta >= ietamax) {
-        music_message << "[HydroinfoMUSIC::getHydroValues]: WARNING - "
-                      << "eta out of range, ieta=" << ieta
-                      << ", ietamax=" << ietamax;
-        music_message.flush("warning");
-        info->temperature = 0.0;
-        info->ed = 0.0;
-        info->sd = 0.0;
-        info->pressure = 0.0;
-        info->vx = 0.0;
-        info->vy = 0.0;
-        info->vz = 0.0;
-        return;
+    if (store_precision == 2) {
+        interpolate_point(slices_half, pos, z, t, info);
+    } else {
+        interpolate_point(slices_float, pos, z, t, info);
     }
+    return(0);
+}
 
-    // The array of positions on the 4-dimensional rectangle:
-    int position[2][2][2][2];
-    for (int ipx = 0; ipx < 2; ipx++) {
-        int px;
-        if (ipx == 0 || ix == ixmax-1) {
-            px = ix;
-        } else {
-            px = ix + 1;
-        }
-        for (int ipy = 0; ipy < 2; ipy++) {
-            int py;
-            if (ipy == 0 || iy == ixmax-1) {
-                py = iy;
-            } else {
-                py = iy + 1;
-            }
-            for (int ipeta = 0; ipeta < 2; ipeta++) {
-                int peta;
-                if (ipeta == 0 || ieta == ietamax-1) {
-                    peta = ieta;
-                } else {
-                    peta = ieta + 1;
-                }
-                for (int iptau = 0; iptau < 2; iptau++) {
-                    int ptau;
-                    if (iptau == 0 || itau == itaumax-1) {
-                        ptau = itau;
-                    } else {
-                        ptau = itau + 1;
-                    }
-                    position[ipx][ipy][ipeta][iptau] = (
-                                px + ixmax*(py + ixmax*(peta + ietamax*ptau)));
-                }
-            }
-        }
-    }
 
-    // And now, the interpolation:
-    double T = 0.0;
-    double ed = 0.0;
-    double sd = 0.0;
-    double pressure = 0.0;
-    double vx = 0.0;
-    double vy = 0.0;
-    double vz = 0.0;
-    double ux = 0.0;
-    double uy = 0.0;
-    double ueta = 0.0;
-    double pi00 = 0.0;
-    double pi01 = 0.0;
-    double pi02 = 0.0;
-    double pi03 = 0.0;
-    double pi11 = 0.0;
-    double pi12 = 0.0;
-    double pi13 = 0.0;
-    double pi22 = 0.0;
-    double pi23 = 0.0;
-    double pi33 = 0.0;
-    double bulkPi = 0.0;
-
-    fluidCell_ideal *HydroCell_ptr1, *HydroCell_ptr2;
+template <typename T>
+void HydroinfoMUSIC::interpolate_point(
+        const std::vector<std::unique_ptr<T[]>> &slices,
+        const GridPosition &pos, const double z, const double t,
+        fluidCell *info) const {
+    // The corners of the 4-dimensional rectangle, the upper corner falls
+    // back to the lower one at the edges of the grid
+    const int px[2] = {pos.ix, (pos.ix == ixmax - 1) ? pos.ix : pos.ix + 1};
+    const int py[2] = {pos.iy, (pos.iy == iymax - 1) ? pos.iy : pos.iy + 1};
+    const int peta[2] = {pos.ieta, (pos.ieta == ietamax - 1) ? pos.ieta
+                                                             : pos.ieta + 1};
+    const int ptau[2] = {pos.itau, (pos.itau == itaumax - 1) ? pos.itau
+                                                             : pos.itau + 1};
+    const double xfactor[2] = {1. - pos.xfrac, pos.xfrac};
+    const double yfactor[2] = {1. - pos.yfrac, pos.yfrac};
+    const double etafactor[2] = {1. - pos.etafrac, pos.etafrac};
+    const double taufactor[2] = {1. - pos.taufrac, pos.taufrac};
+
+    // And now, the interpolation, one pair of cells along x at a time
+    double values[n_stored_fields] = {0.};
     for (int iptau = 0; iptau < 2; iptau++) {
-        double taufactor;
-        if (iptau == 0)
-            taufactor = 1. - taufrac;
-        else
-            taufactor = taufrac;
         for (int ipeta = 0; ipeta < 2; ipeta++) {
-            double etafactor;
-            if (ipeta == 0)
-                etafactor = 1. - etafrac;
-            else
-                etafactor = etafrac;
             for (int ipy = 0; ipy < 2; ipy++) {
-                double yfactor;
-                if (ipy == 0)
-                    yfactor = 1. - yfrac;
-                else
-                    yfactor = yfrac;
-
-                double prefrac = yfactor*etafactor*taufactor;
-
-                HydroCell_ptr1 = (
-                        &lattice_ideal[position[0][ipy][ipeta][iptau]]);
-                HydroCell_ptr2 = (
-                        &lattice_ideal[position[1][ipy][ipeta][iptau]]);
-                ed += prefrac*((1. - xfrac)*HydroCell_ptr1->ed
-                              + xfrac*HydroCell_ptr2->ed);
-                sd += prefrac*((1. - xfrac)*HydroCell_ptr1->sd
-                              + xfrac*HydroCell_ptr2->sd);
-                pressure += prefrac*((1. - xfrac)*HydroCell_ptr1->pressure
-                                     + xfrac*HydroCell_ptr2->pressure);
-                T += prefrac*((1. - xfrac)*HydroCell_ptr1->temperature
-                              + xfrac*HydroCell_ptr2->temperature);
-                ux += prefrac*((1. - xfrac)*HydroCell_ptr1->ux
-                                + xfrac*HydroCell_ptr2->ux);
-                uy += prefrac*((1. - xfrac)*HydroCell_ptr1->uy
-                                + xfrac*HydroCell_ptr2->uy);
-                ueta += prefrac*((1. - xfrac)*HydroCell_ptr1->ueta
-                                 + xfrac*HydroCell_ptr2->ueta);
+                const double prefrac = (
+                    yfactor[ipy]*etafactor[ipeta]*taufactor[iptau]);
+                const T *slice = slices[ptau[iptau]].get();
+                const T *cell[2];
+                for (int ipx = 0; ipx < 2; ipx++) {
+                    cell[ipx] = slice + (
+                        (static_cast<size_t>(px[ipx])*iymax + py[ipy])*ietamax
+                        + peta[ipeta]);
+                }
+                for (int i = 0; i < n_stored_fields; i++) {
+                    const size_t offset = i*cells_per_slice;
+                    values[i] += prefrac*(
+                          xfactor[0]*load_value(cell[0][offset])
+                        + xfactor[1]*load_value(cell[1][offset]));
+                }
             }
         }
     }
 
-    double eta_local = 0.5*log((t + z)/(t - z));
+    double eta_local = pos.eta;
+    if (use_tau_eta_coordinate != 1) {
+        eta_local = 0.5*log((t + z)/(t - z));
+    }
     double sinh_eta, cosh_eta;
     if (fabs(eta_local) < 1e-6) {
         // use Taylor expansion for small eta_s to speed up
@@ -252,62 +269,53 @@ void HydroinfoMUSIC::getHydroValues(
         sinh_eta = sinh(eta_local);
         cosh_eta = cosh(eta_local);
     }
+    const double ux   = values[UX];
+    const double uy   = values[UY];
+    const double ueta = values[UETA];
     double utau = sqrt(1. + ux*ux + uy*uy + ueta*ueta);
     double uz = utau*sinh_eta + ueta*cosh_eta;
     double ut = utau*cosh_eta + ueta*sinh_eta;
-    vx = ux/ut;
-    vy = uy/ut;
-    vz = uz/ut;
-
-    info->temperature = static_cast<float>(T);
-    info->vx = static_cast<float>(vx);
-    info->vy = static_cast<float>(vy);
-    info->vz = static_cast<float>(vz);
-
-    info->ed = static_cast<float>(ed);
-    info->sd = static_cast<float>(sd);
-    info->pressure = static_cast<float>(pressure);
-
-    info->pi[0][0] = static_cast<float>(pi00);
-    info->pi[0][1] = static_cast<float>(pi01);
-    info->pi[0][2] = static_cast<float>(pi02);
-    info->pi[0][3] = static_cast<float>(pi03);
-    info->pi[1][0] = static_cast<float>(pi01);
-    info->pi[1][1] = static_cast<float>(pi11);
-    info->pi[1][2] = static_cast<float>(pi12);
-    info->pi[1][3] = static_cast<float>(pi13);
-    info->pi[2][0] = static_cast<float>(pi02);
-    info->pi[2][1] = static_cast<float>(pi12);
-    info->pi[2][2] = static_cast<float>(pi22);
-    info->pi[2][3] = static_cast<float>(pi23);
-    info->pi[3][0] = static_cast<float>(pi03);
-    info->pi[3][1] = static_cast<float>(pi13);
-    info->pi[3][2] = static_cast<float>(pi23);
-    info->pi[3][3] = static_cast<float>(pi33);
-
-    info->bulkPi = static_cast<float>(bulkPi);
+
+    info->temperature = static_cast<float>(values[TEMPERATURE]);
+    info->vx = static_cast<float>(ux/ut);
+    info->vy = static_cast<float>(uy/ut);
+    info->vz = static_cast<float>(uz/ut);
+
+    info->ed = static_cast<float>(values[ED]);
+    info->sd = static_cast<float>(values[SD]);
+    info->pressure = static_cast<float>(values[PRESSURE]);
+
+    // the viscous tensors are not stored
+    for (int mu = 0; mu < 4; mu++) {
+        for (int nu = 0; nu < 4; nu++) {
+            info->pi[mu][nu] = 0.;
+        }
+    }
+    info->bulkPi = 0.;
 }
 
 
 void HydroinfoMUSIC::get_fluid_cell_with_index(const int idx,
                                                fluidCell *info) const {
-    info->temperature = static_cast<float>(lattice_ideal[idx].temperature);
-    
-    double ux   = lattice_ideal[idx].ux;
-    double uy   = lattice_ideal[idx].uy;
-    double ueta = lattice_ideal[idx].ueta;
+    fluidCell_ideal cell;
+    get_cell(idx, cell);
+    info->temperature = static_cast<float>(cell.temperature);
+
+    double ux   = cell.ux;
+    double uy   = cell.uy;
+    double ueta = cell.ueta;
     double utau = sqrt(1. + ux*ux + uy*uy + ueta*ueta);
-    double sinh_eta = sinh(lattice_ideal[idx].eta);
-    double cosh_eta = cosh(lattice_ideal[idx].eta);
+    double sinh_eta = sinh(cell.eta);
+    double cosh_eta = cosh(cell.eta);
     double uz = utau*sinh_eta + ueta*cosh_eta;
     double ut = utau*cosh_eta + ueta*sinh_eta;
     info->vx = static_cast<float>(ux/ut);
     info->vy = static_cast<float>(uy/ut);
     info->vz = static_cast<float>(uz/ut);
 
-    info->ed = static_cast<float>(lattice_ideal[idx].ed);
-    info->sd = static_cast<float>(lattice_ideal[idx].sd);
-    info->pressure = static_cast<float>(lattice_ideal[idx].pressure);
+    info->ed = static_cast<float>(cell.ed);
+    info->sd = static_cast<float>(cell.sd);
+    info->pressure = static_cast<float>(cell.pressure);
 
     info->pi[0][0] = static_cast<float>(0.0);
     info->pi[0][1] = static_cast<float>(0.0);
@@ -331,12 +339,15 @@ void HydroinfoMUSIC::get_fluid_cell_with_index(const int idx,
 
 
 void HydroinfoMUSIC::set_grid_infomatioin(const InitData &DATA) {
+    clean_hydro_event();
     use_tau_eta_coordinate = 1;
     boost_invariant = DATA.boost_invariant;
+    store_precision = DATA.store_hydro_info_precision;
 
     hydroTau0 = DATA.tau0;
     hydroDtau = DATA.delta_tau*DATA.output_evolution_every_N_timesteps;
     hydroDx   = DATA.delta_x*DATA.output_evolution_every_N_x;
+    hydroDy   = DATA.delta_y*DATA.output_evolution_every_N_y;
     hydroDeta = DATA.delta_eta*DATA.output_evolution_every_N_eta;
 
     hydroXmax     = DATA.x_size/2.;
@@ -344,8 +355,31 @@ void HydroinfoMUSIC::set_grid_infomatioin(const InitData &DATA) {
 
     ixmax   = (static_cast<int>((DATA.nx - 1)
                                 /DATA.output_evolution_every_N_x) + 1);
+    iymax   = (static_cast<int>((DATA.ny - 1)
+                                /DATA.output_evolution_every_N_y) + 1);
     ietamax = (static_cast<int>((DATA.neta - 1)
                                 /DATA.output_evolution_every_N_eta) + 1);
+    cells_per_slice = static_cast<size_t>(ixmax)*iymax*ietamax;
+
+    eta_values.assign(ietamax, 0.);
+    if (DATA.boost_invariant == 0) {
+        for (int ieta = 0; ieta < ietamax; ieta++) {
+            const int ieta_grid = ieta*DATA.output_evolution_every_N_eta;
+            eta_values[ieta] = static_cast<float>(
+                static_cast<double>(ieta_grid)*DATA.delta_eta
+                - DATA.eta_size/2.0);
+        }
+    }
+
+    // the slices themselves are allocated when they are written, so that
+    // an evolution that stops early at freeze-out only takes what it needs
+    const int n_slices = (DATA.nt/DATA.output_evolution_every_N_timesteps
+                          + 1);
+    if (store_precision == 2) {
+        slices_half.reserve(n_slices);
+    } else {
+        slices_float.reserve(n_slices);
+    }
 }
 
 void HydroinfoMUSIC::print_grid_information() {
@@ -363,21 +397,225 @@ void HydroinfoMUSIC::print_grid_information() {
     music_message.flush("info");
 }
 
-void HydroinfoMUSIC::dump_ideal_info_to_memory(double tau, float eta,
-        float epsilon, float pressure, float entropy, float T,
-        float ux, float uy, float ueta) {
-    if (tau > hydroTauMax) {
-        hydroTauMax = tau;
-        itaumax++;
+void HydroinfoMUSIC::add_time_slice(double tau) {
+    hydroTauMax = tau;
+    itaumax++;
+    // the values are written in parallel by the caller, which also
+    // places the pages on the NUMA nodes of the writing threads
+    const size_t slice_size = n_stored_fields*cells_per_slice;
+    if (store_precision == 2) {
+        slices_half.emplace_back(new uint16_t[slice_size]);
+    } else {
+        slices_float.emplace_back(new float[slice_size]);
+    }
+}
+
+void HydroinfoMUSIC::store_fluid_cell(const int ix, const int iy,
+        const int ieta, float epsilon, float pressure, float entropy,
+        float T, float ux, float uy, float ueta) {
+    float values[n_stored_fields];
+    values[ED] = epsilon*Util::hbarc;
+    values[SD] = entropy;
+    values[PRESSURE] = pressure*Util::hbarc;
+    values[TEMPERATURE] = T*Util::hbarc;
+    values[UX] = ux;
+    values[UY] = uy;
+    values[UETA] = ueta;
+    const size_t icell = (static_cast<size_t>(ix)*iymax + iy)*ietamax + ieta;
+    if (store_precision == 2) {
+        uint16_t *slice = slices_half.back().get();
+        for (int i = 0; i < n_stored_fields; i++) {
+            slice[i*cells_per_slice + icell] = float_to_half(values[i]);
+        }
+    } else {
+        float *slice = slices_float.back().get();
+        for (int i = 0; i < n_stored_fields; i++) {
+            slice[i*cells_per_slice + icell] = values[i];
+        }
+    }
+}
+
+void HydroinfoMUSIC::get_cell(const size_t idx, fluidCell_ideal &cell) const {
+    const size_t islice = idx/cells_per_slice;
+    const size_t icell = idx - islice*cells_per_slice;
+    float values[n_stored_fields];
+    if (store_precision == 2) {
+        const uint16_t *slice = slices_half[islice].get();
+        for (int i = 0; i < n_stored_fields; i++) {
+            values[i] = half_to_float(slice[i*cells_per_slice + icell]);
+        }
+    } else {
+        const float *slice = slices_float[islice].get();
+        for (int i = 0; i < n_stored_fields; i++) {
+            values[i] = slice[i*cells_per_slice + icell];
+        }
+    }
+    cell.eta = eta_values[icell%ietamax];
+    cell.ed = values[ED];
+    cell.sd = values[SD];
+    cell.pressure = values[PRESSURE];
+    cell.temperature = values[TEMPERATURE];
+    cell.ux = values[UX];
+    cell.uy = values[UY];
+    cell.ueta = values[UETA];
+}
+
+
+TEST_CASE("check the half precision storage of the hydro history") {
+    CHECK(half_to_float(float_to_half(0.f)) == 0.f);
+    CHECK(half_to_float(float_to_half(1.f)) == 1.f);
+    CHECK(half_to_float(float_to_half(-2.5f)) == -2.5f);
+    CHECK(half_to_float(float_to_half(65504.f)) == 65504.f);
+    CHECK(half_to_float(float_to_half(1e6f)) == INFINITY);
+    CHECK(half_to_float(float_to_half(5.9604645e-8f)) == 5.9604645e-8f);
+    CHECK(half_to_float(float_to_half(1e-9f)) == 0.f);
+    // 1 + 2^-11 lies halfway between two halfs and rounds to the even one
+    CHECK(half_to_float(float_to_half(1.00048828125f)) == 1.f);
+    for (float value = 1e-4f; value < 6e4f; value *= 1.37f) {
+        const float stored = half_to_float(float_to_half(value));
+        CHECK(std::abs(stored - value) <= value/2048.f);
     }
-    fluidCell_ideal new_cell;
-    new_cell.eta = eta;
-    new_cell.temperature = T*Util::hbarc;
-    new_cell.ed = epsilon*Util::hbarc;
-    new_cell.sd = entropy;
-    new_cell.pressure = pressure*Util::hbarc;
-    new_cell.ux = ux;
-    new_cell.uy = uy;
-    new_cell.ueta = ueta;
-    lattice_ideal.push_back(new_cell);
+}
+
+
+TEST_CASE("check the batched query of the stored hydro history") {
+    InitData DATA;
+    DATA.boost_invariant = 0;
+    DATA.store_hydro_info_precision = 4;
+    DATA.tau0 = 0.5;
+    DATA.delta_tau = 0.1;
+    DATA.nt = 10;
+    DATA.nx = 5;
+    DATA.ny = 5;
+    DATA.neta = 4;
+    DATA.x_size = 4.;
+    DATA.delta_x = 1.;
+    DATA.delta_y = 1.;
+    DATA.eta_size = 2.;
+    DATA.delta_eta = 0.5;
+    DATA.output_evolution_every_N_timesteps = 1;
+    DATA.output_evolution_every_N_x = 1;
+    DATA.output_evolution_every_N_y = 1;
+    DATA.output_evolution_every_N_eta = 1;
+
+    // a static medium with an energy density that only depends on tau
+    HydroinfoMUSIC hydro_info;
+    hydro_info.set_grid_infomatioin(DATA);
+    for (int itau = 0; itau < 3; itau++) {
+        const double tau = DATA.tau0 + itau*DATA.delta_tau;
+        hydro_info.add_time_slice(tau);
+        for (int ix = 0; ix < DATA.nx; ix++) {
+            for (int iy = 0; iy < DATA.ny; iy++) {
+                for (int ieta = 0; ieta < DATA.neta; ieta++) {
+                    const double ed = 10. + 4.*tau;
+                    hydro_info.store_fluid_cell(ix, iy, ieta, ed/Util::hbarc,
+                                                0., 0., 0., 0., 0., 0.);
+                }
+            }
+        }
+    }
+    CHECK(hydro_info.get_number_of_fluid_cells() == 3*5*5*4);
+
+    const double tau = 0.63;
+    const double eta = 0.2;
+    const double x[2] = {0.3, 10.};
+    const double y[2] = {-0.7, -0.7};
+    const double z[2] = {tau*sinh(eta), tau*sinh(eta)};
+    const double t[2] = {tau*cosh(eta), tau*cosh(eta)};
+    fluidCell cells[2];
+    CHECK(hydro_info.getHydroValues(2, x, y, z, t, cells) == 1);
+    CHECK(cells[0].ed == doctest::Approx(10. + 4.*tau));
+    CHECK(cells[0].vx == 0.);
+    CHECK(cells[0].vz == doctest::Approx(tanh(eta)));
+    CHECK(cells[1].ed == 0.);
+
+    fluidCell cell;
+    hydro_info.getHydroValues(x[0], y[0], z[0], t[0], &cell);
+    CHECK(cell.ed == cells[0].ed);
+    CHECK(cell.vz == cells[0].vz);
+}
+
+
+TEST_CASE("check the stored hydro history at the grid points") {
+    InitData DATA;
+    DATA.boost_invariant = 0;
+    DATA.store_hydro_info_precision = 4;
+    DATA.tau0 = 0.5;
+    DATA.delta_tau = 0.1;
+    DATA.nt = 10;
+    DATA.nx = 5;
+    DATA.ny = 4;
+    DATA.neta = 3;
+    DATA.x_size = 4.;
+    DATA.delta_x = 1.;
+    DATA.delta_y = 1.;
+    DATA.eta_size = 1.5;
+    DATA.delta_eta = 0.5;
+    DATA.output_evolution_every_N_timesteps = 1;
+    DATA.output_evolution_every_N_x = 1;
+    DATA.output_evolution_every_N_y = 1;
+    DATA.output_evolution_every_N_eta = 1;
+
+    // an energy density that is linear in tau, x, y and eta, so every
+    // cell is different and the interpolation has to reproduce it
+    auto energy_density = [](const double tau, const double x,
+                             const double y, const double eta) {
+        return(10. + x + 2.*y + 3.*eta + 4.*tau);
+    };
+    HydroinfoMUSIC hydro_info;
+    hydro_info.set_grid_infomatioin(DATA);
+    const int ntau = 3;
+    for (int itau = 0; itau < ntau; itau++) {
+        const double tau = DATA.tau0 + itau*DATA.delta_tau;
+        hydro_info.add_time_slice(tau);
+        for (int ix = 0; ix < DATA.nx; ix++) {
+            for (int iy = 0; iy < DATA.ny; iy++) {
+                for (int ieta = 0; ieta < DATA.neta; ieta++) {
+                    const double x = ix*DATA.delta_x - DATA.x_size/2.;
+                    const double y = iy*DATA.delta_y - DATA.x_size/2.;
+                    const double eta = ieta*DATA.delta_eta - DATA.eta_size/2.;
+                    const double ed = energy_density(tau, x, y, eta);
+                    hydro_info.store_fluid_cell(ix, iy, ieta, ed/Util::hbarc,
+                                                0., 0., 0., 0., 0., 0.);
+                }
+            }
+        }
+    }
+
+    // a query at a grid point returns the cell that is stored there
+    int idx = 0;
+    for (int itau = 0; itau < ntau; itau++) {
+        for (int ix = 0; ix < DATA.nx; ix++) {
+            for (int iy = 0; iy < DATA.ny; iy++) {
+                for (int ieta = 0; ieta < DATA.neta; ieta++) {
+                    const double tau = DATA.tau0 + itau*DATA.delta_tau;
+                    const double x = ix*DATA.delta_x - DATA.x_size/2.;
+                    const double y = iy*DATA.delta_y - DATA.x_size/2.;
+                    const double eta = ieta*DATA.delta_eta - DATA.eta_size/2.;
+                    fluidCell stored, queried;
+                    hydro_info.get_fluid_cell_with_index(idx, &stored);
+                    hydro_info.getHydroValues(x, y, tau*sinh(eta),
+                                              tau*cosh(eta), &queried);
+                    CHECK(queried.ed == doctest::Approx(stored.ed));
+                    CHECK(stored.ed
+                          == doctest::Approx(energy_density(tau, x, y, eta)));
+                    idx++;
+                }
+            }
+        }
+    }
+
+    // and in between the interpolation is exact for a linear field
+    const double tau = 0.63;
+    const double eta = 0.2;
+    fluidCell cell;
+    hydro_info.getHydroValues(0.3, 0.6, tau*sinh(eta), tau*cosh(eta), &cell);
+    CHECK(cell.ed == doctest::Approx(energy_density(tau, 0.3, 0.6, eta)));
+
+    // nothing is read behind the last stored slice
+    const double x[1] = {0.3};
+    const double y[1] = {0.6};
+    const double z[1] = {0.9*sinh(eta)};
+    const double t[1] = {0.9*cosh(eta)};
+    CHECK(hydro_info.getHydroValues(1, x, y, z, t, &cell) == 1);
 }
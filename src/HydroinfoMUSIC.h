@@ -3,6 +3,8 @@
 #ifndef SRC_HYDROINFOMUSIC_H_
 #define SRC_HYDROINFOMUSIC_H_
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include "data_struct.h"
@@ -19,17 +21,60 @@ class HydroinfoMUSIC {
     double hydro_eta_max;   // maximum z in fm in the hydro data files
                             // [-zmax, +zmax] for 3D hydro
     double hydroDx;         // step dx in fm in the hydro data files
+    double hydroDy;         // step dy in fm in the hydro data files
     double hydroDeta;       // step dz in fm in the hydro data files in
                             // the z-direction for 3D hydro
 
     int use_tau_eta_coordinate;
     bool boost_invariant;
 
-    int itaumax, ixmax, ietamax;
+    int itaumax, ixmax, iymax, ietamax;
 
-    std::vector<fluidCell_ideal> lattice_ideal;
+    //! The evolution history is stored in columns: every time slice is one
+    //! block of n_stored_fields arrays of cells_per_slice values, the
+    //! array of a field starts at field*cells_per_slice. The cells of a
+    //! slice are ordered as idx = (ix*iymax + iy)*ietamax + ieta. The
+    //! space-time rapidity only depends on ieta and is kept once in
+    //! eta_values. Depending on store_precision the values are stored as
+    //! float (4) or as IEEE half precision (2).
+    enum StoredField {ED, SD, PRESSURE, TEMPERATURE, UX, UY, UETA,
+                      n_stored_fields};
+    int store_precision;
+    size_t cells_per_slice;
+    std::vector<float> eta_values;
+    std::vector<std::unique_ptr<float[]>> slices_float;
+    std::vector<std::unique_ptr<uint16_t[]>> slices_half;
     pretty_ostream music_message;
 
+    //! a space-time point on the stored grid, with the lower corner of the
+    //! cell around it and the fractions of the way to the upper one
+    struct GridPosition {
+        double tau, eta;
+        int itau, ix, iy, ieta;
+        double taufrac, xfrac, yfrac, etafrac;
+    };
+
+    //! locates (x, y, z, t) on the stored grid. Returns 0 if the point is
+    //! inside, or 1, 2, 3, 4 if x, y, tau or eta is out of range
+    int locate_point(const double x, const double y, const double z,
+                     const double t, GridPosition &pos) const;
+
+    //! the interpolation of getHydroValues without any message. Points
+    //! outside of the grid give a cell with all values 0, the return value
+    //! is the one of locate_point
+    int interpolate_fluid_cell(const double x, const double y,
+                               const double z, const double t,
+                               GridPosition &pos, fluidCell *info) const;
+
+    template <typename T>
+    void interpolate_point(const std::vector<std::unique_ptr<T[]>> &slices,
+                           const GridPosition &pos, const double z,
+                           const double t, fluidCell *info) const;
+
+    //! decodes the stored cell with the global index
+    //! idx = itau*cells_per_slice + (ix*iymax + iy)*ietamax + ieta
+    void get_cell(const size_t idx, fluidCell_ideal &cell) const;
+
  public:
     HydroinfoMUSIC();       // constructor
     ~HydroinfoMUSIC();      // destructor
@@ -50,13 +95,33 @@ class HydroinfoMUSIC {
     void getHydroValues(const double x, const double y,
                         const double z, const double t,
                         fluidCell *info);
+
+    //! batched version of getHydroValues for the n points
+    //! (x[i], y[i], z[i], t[i]). It only reads the stored evolution and
+    //! prints no messages, so it can be called from many threads at the
+    //! same time. Points outside of the grid give cells with all values 0,
+    //! the function returns the number of such points
+    int getHydroValues(const int n, const double *x, const double *y,
+                       const double *z, const double *t,
+                       fluidCell *info) const;
+    //! sets up the grid of the stored evolution and drops the previous one
     void set_grid_infomatioin(const InitData &DATA);
     void print_grid_information();
-    void dump_ideal_info_to_memory(double tau, float eta, float epsilon,
-                                   float pressure, float entropy, float T,
-                                   float ux, float uy, float ueta);
 
-    int get_number_of_fluid_cells() const {return(lattice_ideal.size());}
+    //! allocates the time slice for the output at tau, the cells are then
+    //! filled with store_fluid_cell
+    void add_time_slice(double tau);
+
+    //! stores one cell of the last time slice. The indices are the ones of
+    //! the output grid. Different cells can be stored from different
+    //! threads at the same time
+    void store_fluid_cell(const int ix, const int iy, const int ieta,
+                          float epsilon, float pressure, float entropy,
+                          float T, float ux, float uy, float ueta);
+
+    int get_number_of_fluid_cells() const {
+        return(static_cast<int>(itaumax*cells_per_slice));
+    }
     void get_fluid_cell_with_index(const int idx, fluidCell *info) const;
 };
 
@@ -6,7 +6,11 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "util.h"
 #include "data.h"
@@ -16,6 +20,8 @@
 #include "eos.h"
 #include "evolve.h"
 #include "advance.h"
+#include "read_in_parameters.h"
+#include "doctest.h"
 
 using Util::map_2d_idx_to_1d;
 using Util::map_1d_idx_to_2d;
@@ -26,8 +32,16 @@ Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
     DATA(DATA_in), eos(eosIn),
     diss_helper(eosIn, DATA_in),
     minmod(DATA_in),
-    reconst_helper(eos, DATA_in) {
+    reconst_helper(eos, DATA_in),
+    rk_scheme(DATA_in.rk_order) {
 
+    set_hydro_source_terms(hydro_source_ptr_in);
+}
+
+
+//! This function sets the hydro source terms of the next event
+void Advance::set_hydro_source_terms(
+        std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) {
     hydro_source_terms_ptr = hydro_source_ptr_in;
     flag_add_hydro_source = false;
     if (!Util::weak_ptr_is_uninitialized(hydro_source_terms_ptr)) {
@@ -41,15 +55,36 @@ Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
     }
 }
 
-//! this function evolves one Runge-Kutta step in tau
+//! this function evolves one Runge-Kutta stage in tau
 void Advance::AdvanceIt(double tau, SCGrid &arena_prev, SCGrid &arena_current,
                        SCGrid &arena_future, int rk_flag) {
-  const int grid_neta = arena_current.nEta();
+    if (DATA.flux_sweep_mode == 1) {
+        MakeFaceFluxes(rk_scheme.get_stage_tau(tau, DATA.delta_tau, rk_flag),
+                       arena_current);
+    }
+    AdvanceSlab(tau, arena_prev, arena_current, arena_future, rk_flag,
+                0, arena_current.nEta());
+}
+
+
+//! this function evolves the cells with ieta_begin <= ieta < ieta_end by
+//! one Runge-Kutta stage. It reads arena_current within the stencil
+//! (two cells) around the slab, and arena_prev only inside the slab
+void Advance::AdvanceSlab(double tau, SCGrid &arena_prev,
+                          SCGrid &arena_current, SCGrid &arena_future,
+                          int rk_flag, int ieta_begin, int ieta_end) {
   const int grid_nx   = arena_current.nX();
   const int grid_ny   = arena_current.nY();
-
-    #pragma omp parallel for collapse(3) schedule(guided)
-    for (int ieta = 0; ieta < grid_neta; ieta++)
+  const double delta_tau_prev = rk_scheme.get_delta_tau_prev(DATA.delta_tau,
+                                                             rk_flag);
+  // arena_current holds the stage state U^(rk_flag), so its derivatives
+  // and the dissipative sources are evaluated at the stage time
+  const double tau_rk = rk_scheme.get_stage_tau(tau, DATA.delta_tau, rk_flag);
+    reconst_helper.prepare_statistics();
+
+    // static partition, the same as the first touch of the grids in GridT
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = ieta_begin; ieta < ieta_end; ieta++)
     for (int ix   = 0; ix   < grid_nx;   ix++  )
     for (int iy   = 0; iy   < grid_ny;   iy++  ) {
         double eta_s_local = - DATA.eta_size/2. + ieta*DATA.delta_eta;
@@ -62,22 +97,23 @@ void Advance::AdvanceIt(double tau, SCGrid &arena_prev, SCGrid &arena_current,
 
         if (DATA.viscosity_flag == 1) {
             U_derivative u_derivative_helper(DATA, eos);
-            u_derivative_helper.MakedU(tau, arena_prev, arena_current,
+            u_derivative_helper.MakedU(tau_rk, delta_tau_prev,
+                                       arena_prev, arena_current,
                                        ix, iy, ieta);
             double theta_local = u_derivative_helper.calculate_expansion_rate(
-                                            tau, arena_current, ieta, ix, iy);
+                                        tau_rk, arena_current, ieta, ix, iy);
             DumuVec a_local;
-            u_derivative_helper.calculate_Du_supmu(tau, arena_current,
+            u_derivative_helper.calculate_Du_supmu(tau_rk, arena_current,
                                                    ieta, ix, iy, a_local);
             VelocityShearVec sigma_local;
             u_derivative_helper.calculate_velocity_shear_tensor(
-                        tau, arena_current, ieta, ix, iy, a_local, sigma_local);
+                    tau_rk, arena_current, ieta, ix, iy, a_local, sigma_local);
 
             DmuMuBoverTVec baryon_diffusion_vector;
             u_derivative_helper.get_DmuMuBoverTVec(baryon_diffusion_vector);
 
-            FirstRKStepW(tau,  arena_prev, arena_current, arena_future, rk_flag,
-                         theta_local, a_local, sigma_local,
+            FirstRKStepW(tau_rk, arena_prev, arena_current, arena_future,
+                         rk_flag, theta_local, a_local, sigma_local,
                          baryon_diffusion_vector, ieta, ix, iy);
         }
     }
@@ -88,14 +124,13 @@ void Advance::AdvanceIt(double tau, SCGrid &arena_prev, SCGrid &arena_current,
 void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
         double eta_s_local, SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev, int ix, int iy, int ieta, int rk_flag) {
     // this advances the ideal part
-    double tau_rk = tau + rk_flag*(DATA.delta_tau);
+    const double tau_rk = rk_scheme.get_stage_tau(tau, DATA.delta_tau,
+                                                  rk_flag);
     
     // Solve partial_a T^{a mu} = -partial_a W^{a mu}
     // Update T^{mu nu}
     
-    // MakeDelatQI gets
-    //   qi = q0 if rk_flag = 0 or
-    //   qi = q0 + k1 if rk_flag = 1
+    // MakeDelatQI gets qi = tau_rk T^{tau mu} of the stage state U^(rk_flag)
     // rhs[alpha] is what MakeDeltaQI outputs. 
     // It is the spatial derivative part of partial_a T^{a mu}
     // (including geometric terms)
@@ -123,8 +158,11 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
     // now MakeWSource returns partial_a W^{a mu}
     // (including geometric terms)
     TJbVec dwmn ={0.0};
-    diss_helper.MakeWSource(tau_rk, arena_current, arena_prev, ix, iy, ieta,
-                            dwmn);
+    const double alpha_rk = rk_scheme.get_alpha(rk_flag);
+    diss_helper.MakeWSource(tau_rk,
+                            rk_scheme.get_delta_tau_prev(DATA.delta_tau,
+                                                         rk_flag),
+                            arena_current, arena_prev, ix, iy, ieta, dwmn);
     for (int alpha = 0; alpha < 5; alpha++) {
         /* dwmn is the only one with the minus sign */
         qi[alpha] -= dwmn[alpha]*(DATA.delta_tau);
@@ -141,19 +179,29 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
         //        qi[alpha] = 0.;
         //}
 
-        /* if rk_flag > 0, we now have q0 + k1 + k2. 
-         * So add q0 and multiply by 1/2 */
-        qi[alpha] += rk_flag*get_TJb(arena_prev(ix,iy,ieta), alpha, 0)*tau;
-        qi[alpha] *= 1./(1. + rk_flag);
+        /* qi is now the Euler step of the stage state. Combine it with
+         * q0 from the beginning of the time step (Shu-Osher form) */
+        qi[alpha] = (alpha_rk*get_TJb(arena_prev(ix,iy,ieta), alpha, 0)*tau
+                     + (1. - alpha_rk)*qi[alpha]);
     }
  
-    double tau_next = tau + DATA.delta_tau;
+    const double tau_next = rk_scheme.get_stage_tau(tau, DATA.delta_tau,
+                                                    rk_flag + 1);
+    // in the first stage, arena_prev and arena_current are the two
+    // previous time steps, so u^tau can be extrapolated to tau_next
+    double u0_guess = 0.;
+    if (rk_flag == 0 && reconst_helper.get_initial_guess_mode() == 1) {
+        u0_guess = std::max(1., 2.*arena_current(ix, iy, ieta).u[0]
+                                - arena_prev(ix, iy, ieta).u[0]);
+    }
     auto grid_rk_t = reconst_helper.ReconstIt_shell(
-                                tau_next, qi, arena_current(ix, iy, ieta)); 
+                tau_next, qi, arena_current(ix, iy, ieta), u0_guess);
     UpdateTJbRK(grid_rk_t, arena_future(ix, iy, ieta));
 }
 
 
+//! this advances the dissipative part. tau is the time of the stage state
+//! U^(rk_flag) in arena_current
 void Advance::FirstRKStepW(
     double tau, SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future,
     int rk_flag, double theta_local, DumuVec &a_local,
@@ -163,7 +211,7 @@ void Advance::FirstRKStepW(
     auto grid_pt_c = &(arena_current(ix, iy, ieta));
     auto grid_pt_f = &(arena_future(ix, iy, ieta));
 
-    const double tau_now  = tau + rk_flag*DATA.delta_tau;
+    const double alpha_rk = rk_scheme.get_alpha(rk_flag);
 
     // Solve partial_a (u^a W^{mu nu}) = 0
     // Update W^{mu nu}
@@ -174,25 +222,31 @@ void Advance::FirstRKStepW(
     // with the KT flux
     // solve partial_tau (u^0 W^{kl}) = -partial_i (u^i W^{kl}
     /* Advance uWmunu */
-    double tempf, temps;
+    // the KT fluxes and the sources of all the components are computed
+    // together, so that the stencil and the EoS are only fetched once
+    ViscousVec w_rhs    = {0.};
+    ViscousVec w_source = {0.};
+    double p_rhs     = 0.;
+    double pi_source = 0.;
+    if (DATA.turn_on_shear == 1 || DATA.turn_on_bulk == 1
+            || DATA.turn_on_diff == 1) {
+        diss_helper.Make_uWRHS(tau, arena_current, ix, iy, ieta,
+                               theta_local, a_local, w_rhs, p_rhs);
+        diss_helper.Make_uWSource(tau, grid_pt_c, theta_local, a_local,
+                                  sigma_local, baryon_diffusion_vector,
+                                  w_source, pi_source);
+    }
+
+    double tempf;
     if (DATA.turn_on_shear == 1) {
-        #pragma omp simd
         for (int idx_1d = 4; idx_1d < 9; idx_1d++) {
-            double w_rhs = 0.;
-            int mu = 0;
-            int nu = 0;
-            map_1d_idx_to_2d(idx_1d, mu, nu);
-            diss_helper.Make_uWRHS(tau_now, arena_current, ix, iy, ieta,
-                                   mu, nu, w_rhs, theta_local, a_local);
-            tempf = ((1. - rk_flag)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
-                     + rk_flag*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0]));
-            temps = diss_helper.Make_uWSource(
-                    tau_now, grid_pt_c, grid_pt_prev, mu, nu, rk_flag,
-                    theta_local, a_local, sigma_local);
-            tempf += temps*(DATA.delta_tau);
-            tempf += w_rhs;
-            tempf += rk_flag*((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
-            tempf *= 1./(1. + rk_flag);
+            // Euler step of the stage state, combined with the beginning
+            // of the time step
+            tempf = grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0];
+            tempf += w_source[idx_1d]*(DATA.delta_tau);
+            tempf += w_rhs[idx_1d];
+            tempf = (alpha_rk*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0])
+                     + (1. - alpha_rk)*tempf);
             grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
         }
     } else {
@@ -203,18 +257,11 @@ void Advance::FirstRKStepW(
     }
 
     if (DATA.turn_on_bulk == 1) {
-        double p_rhs;
-        diss_helper.Make_uPRHS(tau_now, arena_current, ix, iy, ieta,
-                               &p_rhs, theta_local);
-        tempf = ((1. - rk_flag)*(grid_pt_c->pi_b*grid_pt_c->u[0])
-                 + rk_flag*(grid_pt_prev->pi_b*grid_pt_prev->u[0]));
-        temps = diss_helper.Make_uPiSource(
-                tau_now, grid_pt_c, grid_pt_prev, rk_flag,
-                theta_local, sigma_local);
-        tempf += temps*(DATA.delta_tau);
+        tempf = grid_pt_c->pi_b*grid_pt_c->u[0];
+        tempf += pi_source*(DATA.delta_tau);
         tempf += p_rhs;
-        tempf += rk_flag*((grid_pt_c->pi_b)*(grid_pt_c->u[0]));
-        tempf *= 1./(1. + rk_flag);
+        tempf = (alpha_rk*(grid_pt_prev->pi_b*grid_pt_prev->u[0])
+                 + (1. - alpha_rk)*tempf);
         grid_pt_f->pi_b = tempf/(grid_pt_f->u[0]);
     } else {
         grid_pt_f->pi_b = 0.0;
@@ -222,23 +269,12 @@ void Advance::FirstRKStepW(
 
     // CShen: add source term for baryon diffusion
     if (DATA.turn_on_diff == 1) {
-        int mu = 4;
-        #pragma omp simd
         for (int idx_1d = 11; idx_1d < 14; idx_1d++) {
-            int nu = idx_1d - 10;
-            double w_rhs = diss_helper.Make_uqRHS(
-                        tau_now, arena_current, ix, iy, ieta, mu, nu);
-            tempf = ((1. - rk_flag)*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0])
-                     + rk_flag*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0]));
-            temps = diss_helper.Make_uqSource(
-                        tau_now, grid_pt_c, grid_pt_prev, nu, rk_flag,
-                        theta_local, a_local, sigma_local,
-                        baryon_diffusion_vector);
-            tempf += temps*(DATA.delta_tau);
-            tempf += w_rhs;
-
-            tempf += rk_flag*(grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0]);
-            tempf *= 1./(1. + rk_flag);
+            tempf = grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0];
+            tempf += w_source[idx_1d]*(DATA.delta_tau);
+            tempf += w_rhs[idx_1d];
+            tempf = (alpha_rk*(grid_pt_prev->Wmunu[idx_1d]*grid_pt_prev->u[0])
+                     + (1. - alpha_rk)*tempf);
 
             grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
         }
@@ -453,62 +489,103 @@ void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
     TJbVec rhs     = {0.};
     EnergyFlowVec T_eta_m = {0.};
     EnergyFlowVec T_eta_p = {0.};
-    Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
-        #pragma omp simd
-        for (int alpha = 0; alpha < 5; alpha++) {
-            const double gphL = qi[alpha];
-            const double gphR = tau*get_TJb(p1, alpha, 0);
-            const double gmhL = tau*get_TJb(m1, alpha, 0);
-            const double gmhR = qi[alpha];
-            const double fphL =  0.5*minmod.minmod_dx(gphR, qi[alpha], gmhL);
-            const double fphR = -0.5*minmod.minmod_dx(
-                                tau*get_TJb(p2, alpha, 0), gphR, qi[alpha]);
-            const double fmhL =  0.5*minmod.minmod_dx(
-                                qi[alpha], gmhL, tau*get_TJb(m2, alpha, 0));
-            const double fmhR = -fphL;
-            qiphL[alpha] = gphL + fphL;
-            qiphR[alpha] = gphR + fphR;
-            qimhL[alpha] = gmhL + fmhL;
-            qimhR[alpha] = gmhR + fmhR;
+    if (DATA.flux_sweep_mode == 1) {
+        // the fluxes were computed once per face in MakeFaceFluxes
+        const int dx[4]   = {0, 1, 0, 0};
+        const int dy[4]   = {0, 0, 1, 0};
+        const int deta[4] = {0, 0, 0, 1};
+        for (int direction = 1; direction < 4; direction++) {
+            auto &flux = face_flux[direction - 1];
+            const TJbVec &Fimh = flux(ix, iy, ieta);
+            const TJbVec &Fiph = flux(ix + dx[direction], iy + dy[direction],
+                                      ieta + deta[direction]);
+            #pragma omp simd
+            for (int alpha = 0; alpha < 5; alpha++) {
+                if (direction == 3 && (alpha == 0 || alpha == 3)) {
+                    T_eta_m[alpha] = Fimh[alpha];
+                    T_eta_p[alpha] = Fiph[alpha];
+                } else {
+                    double DFmmp = (Fimh[alpha] - Fiph[alpha])/delta[direction];
+                    rhs[alpha] += DFmmp*(DATA.delta_tau);
+                }
+            }
         }
+    } else {
+        Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
+            // the three slopes of all the fields are limited in one call,
+            // [0, 5) at the cell, [5, 10) at p1 and [10, 15) at m1
+            double up1[15], u[15], um1[15], slope[15];
+            for (int alpha = 0; alpha < 5; alpha++) {
+                const double gp2 = tau*get_TJb(p2, alpha, 0);
+                const double gp1 = tau*get_TJb(p1, alpha, 0);
+                const double gm1 = tau*get_TJb(m1, alpha, 0);
+                const double gm2 = tau*get_TJb(m2, alpha, 0);
+                up1[alpha]      = gp1;
+                u[alpha]        = qi[alpha];
+                um1[alpha]      = gm1;
+                up1[5 + alpha]  = gp2;
+                u[5 + alpha]    = gp1;
+                um1[5 + alpha]  = qi[alpha];
+                up1[10 + alpha] = qi[alpha];
+                u[10 + alpha]   = gm1;
+                um1[10 + alpha] = gm2;
+            }
+            minmod.minmod_dx(up1, u, um1, slope, 15);
+
+            #pragma omp simd
+            for (int alpha = 0; alpha < 5; alpha++) {
+                const double gphL = qi[alpha];
+                const double gphR = u[5 + alpha];
+                const double gmhL = u[10 + alpha];
+                const double gmhR = qi[alpha];
+                const double fphL =  0.5*slope[alpha];
+                const double fphR = -0.5*slope[5 + alpha];
+                const double fmhL =  0.5*slope[10 + alpha];
+                const double fmhR = -fphL;
+                qiphL[alpha] = gphL + fphL;
+                qiphR[alpha] = gphR + fphR;
+                qimhL[alpha] = gmhL + fmhL;
+                qimhR[alpha] = gmhR + fmhR;
+            }
 
-        // for each direction, reconstruct half-way cells
-        // reconstruct e, rhob, and u[4] for half way cells
-        auto grid_phL = reconst_helper.ReconstIt_shell(tau, qiphL, c);
-        auto grid_phR = reconst_helper.ReconstIt_shell(tau, qiphR, c);
-        auto grid_mhL = reconst_helper.ReconstIt_shell(tau, qimhL, c);
-        auto grid_mhR = reconst_helper.ReconstIt_shell(tau, qimhR, c);
-
-        double aiphL = MaxSpeed(tau, direction, grid_phL);
-        double aiphR = MaxSpeed(tau, direction, grid_phR);
-        double aimhL = MaxSpeed(tau, direction, grid_mhL);
-        double aimhR = MaxSpeed(tau, direction, grid_mhR);
-
-        double aiph = std::max(aiphL, aiphR);
-        double aimh = std::max(aimhL, aimhR);
-
-        #pragma omp simd
-        for (int alpha = 0; alpha < 5; alpha++) {
-            double FiphL = get_TJb(grid_phL, 0, alpha, direction)*tau_fac[direction];
-            double FiphR = get_TJb(grid_phR, 0, alpha, direction)*tau_fac[direction];
-            double FimhL = get_TJb(grid_mhL, 0, alpha, direction)*tau_fac[direction];
-            double FimhR = get_TJb(grid_mhR, 0, alpha, direction)*tau_fac[direction];
-
-            // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
-            //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
-            double Fiph = 0.5*((FiphL + FiphR)
-                               - aiph*(qiphR[alpha] - qiphL[alpha]));
-            double Fimh = 0.5*((FimhL + FimhR)
-                               - aimh*(qimhR[alpha] - qimhL[alpha]));
-            if (direction == 3 && (alpha == 0 || alpha == 3)) {
-                T_eta_m[alpha] = Fimh;
-                T_eta_p[alpha] = Fiph;
-            } else {
-                double DFmmp = (Fimh - Fiph)/delta[direction];
-                rhs[alpha] += DFmmp*(DATA.delta_tau);
+            // for each direction, reconstruct half-way cells
+            // reconstruct e, rhob, and u[4] for half way cells
+            auto grid_phL = reconst_helper.ReconstIt_shell(tau, qiphL, c);
+            auto grid_phR = reconst_helper.ReconstIt_shell(tau, qiphR, c);
+            auto grid_mhL = reconst_helper.ReconstIt_shell(tau, qimhL, c);
+            auto grid_mhR = reconst_helper.ReconstIt_shell(tau, qimhR, c);
+
+            double aiphL = MaxSpeed(tau, direction, grid_phL);
+            double aiphR = MaxSpeed(tau, direction, grid_phR);
+            double aimhL = MaxSpeed(tau, direction, grid_mhL);
+            double aimhR = MaxSpeed(tau, direction, grid_mhR);
+
+            double aiph = std::max(aiphL, aiphR);
+            double aimh = std::max(aimhL, aimhR);
+
+            #pragma omp simd
+            for (int alpha = 0; alpha < 5; alpha++) {
+                double FiphL = get_TJb(grid_phL, 0, alpha, direction)*tau_fac[direction];
+                double FiphR = get_TJb(grid_phR, 0, alpha, direction)*tau_fac[direction];
+                double FimhL = get_TJb(grid_mhL, 0, alpha, direction)*tau_fac[direction];
+                double FimhR = get_TJb(grid_mhR, 0, alpha, direction)*tau_fac[direction];
+
+                // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
+                //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
+                double Fiph = 0.5*((FiphL + FiphR)
+                                   - aiph*(qiphR[alpha] - qiphL[alpha]));
+                double Fimh = 0.5*((FimhL + FimhR)
+                                   - aimh*(qimhR[alpha] - qimhL[alpha]));
+                if (direction == 3 && (alpha == 0 || alpha == 3)) {
+                    T_eta_m[alpha] = Fimh;
+                    T_eta_p[alpha] = Fiph;
+                } else {
+                    double DFmmp = (Fimh - Fiph)/delta[direction];
+                    rhs[alpha] += DFmmp*(DATA.delta_tau);
+                }
             }
-        }
-    });
+        });
+    }
 
     // add longitudinal flux with discretized geometric terms
     double cosh_deta = cosh(delta[3]/2.)/(delta[3] + Util::small_eps);
@@ -536,6 +613,142 @@ void Advance::MakeDeltaQI(const double tau, SCGrid &arena_current,
     }
 }
 
+//! This function computes the KT fluxes at all the x, y and eta faces of
+//! the grid for flux_sweep_mode = 1, so that every face is reconstructed
+//! once instead of once from each of its two cells. The faces are
+//! processed in pencils along x, and the left and right states of a
+//! pencil are reconstructed together by the batched Newton solver
+void Advance::MakeFaceFluxes(const double tau, SCGrid &arena_current) {
+    const int grid_neta = arena_current.nEta();
+    const int grid_nx   = arena_current.nX();
+    const int grid_ny   = arena_current.nY();
+    const int n_faces[3][3] = {{grid_nx + 1, grid_ny,     grid_neta    },
+                               {grid_nx,     grid_ny + 1, grid_neta    },
+                               {grid_nx,     grid_ny,     grid_neta + 1}};
+    for (int dir = 0; dir < 3; dir++) {
+        if (face_flux[dir].nX() != n_faces[dir][0]
+                || face_flux[dir].nY() != n_faces[dir][1]
+                || face_flux[dir].nEta() != n_faces[dir][2]) {
+            face_flux[dir] = GridT<TJbVec>(n_faces[dir][0], n_faces[dir][1],
+                                           n_faces[dir][2]);
+        }
+    }
+
+    reconst_helper.prepare_statistics();
+    for (int dir = 0; dir < 3; dir++) {
+        const int face_neta = n_faces[dir][2];
+        const int face_nx   = n_faces[dir][0];
+        const int face_ny   = n_faces[dir][1];
+        #pragma omp parallel
+        {
+            // the left states of the pencil are stored in [0, face_nx),
+            // the right states in [face_nx, 2*face_nx)
+            std::vector<TJbVec> q_face(2*face_nx);
+            std::vector<const Cell_small*> ref_cells(2*face_nx);
+            std::vector<ReconstCell> grid_face(2*face_nx);
+            std::vector<double> stencil(6*5*face_nx);
+            #pragma omp for collapse(2) schedule(guided)
+            for (int ieta = 0; ieta < face_neta; ieta++)
+            for (int iy   = 0; iy   < face_ny;   iy++  ) {
+                MakeFaceStates(tau, arena_current, dir + 1, iy, ieta, face_nx,
+                               stencil.data(), q_face.data(),
+                               ref_cells.data());
+                reconst_helper.ReconstIt_shell(tau, 2*face_nx, q_face.data(),
+                                               ref_cells.data(),
+                                               grid_face.data());
+                for (int ix = 0; ix < face_nx; ix++) {
+                    MakeFaceFlux(tau, dir + 1,
+                                 q_face[ix], q_face[face_nx + ix],
+                                 grid_face[ix], grid_face[face_nx + ix],
+                                 face_flux[dir](ix, iy, ieta));
+                }
+            }
+        }
+    }
+}
+
+
+//! This function computes the reconstructed left and right states
+//! tau*T^{tau mu} at the lower faces of the pencil of cells (ix, iy, ieta),
+//! 0 <= ix < n_faces, in the given direction. The stencil is the same as in
+//! MakeDeltaQI; cells outside of the grid are taken from the boundary.
+//! The stencil values of all cells and fields are gathered field by field
+//! into the work array stencil (6*5*n_faces doubles), so that the slopes
+//! of the whole pencil are limited by two calls of the vectorized minmod.
+//! The left states are stored in q_face[0, n_faces) and fall back to the
+//! left cell in the reconstruction, the right states in
+//! q_face[n_faces, 2*n_faces) and fall back to the right cell
+void Advance::MakeFaceStates(const double tau, SCGrid &arena_current,
+                             const int direction, const int iy,
+                             const int ieta, const int n_faces,
+                             double *stencil, TJbVec *q_face,
+                             const Cell_small* *ref_cells) {
+    const int dx   = (direction == 1) ? 1 : 0;
+    const int dy   = (direction == 2) ? 1 : 0;
+    const int deta = (direction == 3) ? 1 : 0;
+    const int n = 5*n_faces;
+    double *gm2     = stencil;
+    double *gm1     = stencil + n;
+    double *gc      = stencil + 2*n;
+    double *gp1     = stencil + 3*n;
+    double *slope_L = stencil + 4*n;
+    double *slope_R = stencil + 5*n;
+    for (int ix = 0; ix < n_faces; ix++) {
+        const auto &m2 = arena_current.getHalo(ix - 2*dx, iy - 2*dy,
+                                               ieta - 2*deta);
+        const auto &m1 = arena_current.getHalo(ix - dx, iy - dy,
+                                               ieta - deta);
+        const auto &c  = arena_current.getHalo(ix, iy, ieta);
+        const auto &p1 = arena_current.getHalo(ix + dx, iy + dy,
+                                               ieta + deta);
+        for (int alpha = 0; alpha < 5; alpha++) {
+            const int idx = alpha*n_faces + ix;
+            gm2[idx] = tau*get_TJb(m2, alpha, 0);
+            gm1[idx] = tau*get_TJb(m1, alpha, 0);
+            gc[idx]  = tau*get_TJb(c,  alpha, 0);
+            gp1[idx] = tau*get_TJb(p1, alpha, 0);
+        }
+        ref_cells[ix]           = &m1;
+        ref_cells[n_faces + ix] = &c;
+    }
+
+    minmod.minmod_dx(gc,  gm1, gm2, slope_L, n);
+    minmod.minmod_dx(gp1, gc,  gm1, slope_R, n);
+
+    for (int ix = 0; ix < n_faces; ix++) {
+        TJbVec &qL = q_face[ix];
+        TJbVec &qR = q_face[n_faces + ix];
+        for (int alpha = 0; alpha < 5; alpha++) {
+            const int idx = alpha*n_faces + ix;
+            qL[alpha] = gm1[idx] + 0.5*slope_L[idx];
+            qR[alpha] = gc[idx]  - 0.5*slope_R[idx];
+        }
+    }
+}
+
+
+//! This function computes the KT flux from the left and right states at
+//! a face and their reconstructed cells
+void Advance::MakeFaceFlux(const double tau, const int direction,
+                           const TJbVec &qL, const TJbVec &qR,
+                           const ReconstCell &grid_L,
+                           const ReconstCell &grid_R, TJbVec &flux) {
+    const double tau_fac[4] = {0.0, tau, tau, 1.0};
+    const double a = std::max(MaxSpeed(tau, direction, grid_L),
+                              MaxSpeed(tau, direction, grid_R));
+
+    #pragma omp simd
+    for (int alpha = 0; alpha < 5; alpha++) {
+        double FL = get_TJb(grid_L, 0, alpha, direction)*tau_fac[direction];
+        double FR = get_TJb(grid_R, 0, alpha, direction)*tau_fac[direction];
+
+        // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
+        //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
+        flux[alpha] = 0.5*((FL + FR) - a*(qR[alpha] - qL[alpha]));
+    }
+}
+
+
 // determine the maximum signal propagation speed at the given direction
 double Advance::MaxSpeed(double tau, int direc, const ReconstCell &grid_p) {  
     double g[] = {1., 1., 1./tau};
@@ -656,3 +869,80 @@ double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
     const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
     return(T_munu);
 }
+
+
+TEST_CASE("check the order of the viscous Runge-Kutta update") {
+    // the shear stress relaxes towards its Navier-Stokes value while the
+    // fluid expands, so every stage has to evaluate the sources on the
+    // stage state at the stage time for the scheme to keep its order
+    const std::string file_name = "test_viscous_bjorken.dat";
+    std::ofstream input_file(file_name.c_str());
+    input_file << "mode 2" << std::endl
+               << "echo_level 0" << std::endl
+               << "Initial_profile 0" << std::endl
+               << "boost_invariant 1" << std::endl
+               << "EOS_to_use 0" << std::endl
+               << "Grid_size_in_x 1" << std::endl
+               << "Grid_size_in_y 1" << std::endl
+               << "Grid_size_in_eta 1" << std::endl
+               << "Initial_time_tau_0 1.0" << std::endl
+               << "Viscosity_Flag_Yes_1_No_0 1" << std::endl
+               << "Include_Shear_Visc_Yes_1_No_0 1" << std::endl
+               << "Shear_to_S_ratio 0.3" << std::endl
+               << "Include_Bulk_Visc_Yes_1_No_0 0" << std::endl
+               << "turn_on_baryon_diffusion 0" << std::endl;
+    input_file.close();
+    InitData DATA = ReadInParameters::read_in_parameters(file_name);
+    std::remove(file_name.c_str());
+    EOS eos(DATA.whichEOS);
+
+    // evolves a homogeneous Bjorken fluid from tau = 1 to tau_end and
+    // returns epsilon and pi^{eta eta} at the end
+    auto evolve_bjorken = [&](const double tau_end) -> std::array<double, 2> {
+        Advance advance(eos, DATA, nullptr);
+        RKScheme rk_scheme(DATA.rk_order);
+        SCGrid arena_1(1, 1, 1), arena_2(1, 1, 1), arena_3(1, 1, 1);
+        Cell_small &cell = arena_2(0, 0, 0);
+        cell.epsilon = 20.;
+        cell.rhob    = 0.;
+        cell.u       = {1., 0., 0., 0.};
+        cell.Wmunu   = {0.};
+        cell.pi_b    = 0.;
+        arena_1(0, 0, 0) = cell;
+        SCGrid *arena_prev    = &arena_1;
+        SCGrid *arena_current = &arena_2;
+        SCGrid *arena_future  = &arena_3;
+        const int n_steps = static_cast<int>(
+                                (tau_end - 1.)/DATA.delta_tau + 0.5);
+        for (int it = 0; it < n_steps; it++) {
+            const double tau = 1. + it*DATA.delta_tau;
+            for (int rk_flag = 0; rk_flag < rk_scheme.get_n_stages();
+                 rk_flag++) {
+                advance.AdvanceIt(tau, *arena_prev, *arena_current,
+                                  *arena_future, rk_flag);
+                Evolve::rotate_arenas(rk_flag, arena_prev, arena_current,
+                                      arena_future);
+            }
+        }
+        const Cell_small &cell_end = (*arena_current)(0, 0, 0);
+        return {{cell_end.epsilon, cell_end.Wmunu[9]}};
+    };
+
+    const double tau_end = 1.6;
+    for (int order = 2; order < 4; order++) {
+        DATA.rk_order = order;
+        DATA.delta_tau = 0.0025;
+        const auto reference = evolve_bjorken(tau_end);
+        double error[2];
+        for (int i = 0; i < 2; i++) {
+            DATA.delta_tau = 0.04/(1 << i);
+            const auto result = evolve_bjorken(tau_end);
+            error[i] = std::abs(result[1] - reference[1]);
+            CHECK(result[0] == doctest::Approx(reference[0]).epsilon(1e-3));
+        }
+        MESSAGE("order " << order << ": pi^{eta eta} error "
+                << error[0] << " -> " << error[1]);
+        // halving the time step reduces the error by 2^order
+        CHECK(error[0]/error[1] > 0.75*(1 << order));
+    }
+}
@@ -2,6 +2,7 @@
 #ifndef SRC_ADVANCE_H_
 #define SRC_ADVANCE_H_
 
+#include <array>
 #include <memory>
 #include "data.h"
 #include "cell.h"
@@ -10,6 +11,7 @@
 #include "minmod.h"
 #include "u_derivative.h"
 #include "reconst.h"
+#include "rk_scheme.h"
 #include "hydro_source_base.h"
 #include "pretty_ostream.h"
 
@@ -22,17 +24,29 @@ class Advance {
     Diss diss_helper;
     Minmod minmod;
     Reconst reconst_helper;
+    RKScheme rk_scheme;
     pretty_ostream music_message;
 
     bool flag_add_hydro_source;
 
+    //! KT fluxes at the x, y and eta faces for flux_sweep_mode = 1.
+    //! face_flux[dir](ix, iy, ieta) is the flux through the lower face
+    //! of the cell (ix, iy, ieta) in the direction dir + 1
+    std::array<GridT<TJbVec>, 3> face_flux;
+
  public:
     Advance(const EOS &eosIn, const InitData &DATA_in,
             std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
 
+    void set_hydro_source_terms(
+            std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
+
     void AdvanceIt(double tau_init,
                    SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future,
                    int rk_flag);
+    void AdvanceSlab(double tau, SCGrid &arena_prev, SCGrid &arena_current,
+                     SCGrid &arena_future, int rk_flag,
+                     int ieta_begin, int ieta_end);
 
     void FirstRKStepT(const double tau, double x_local, double y_local,
                       double eta_s_local,  SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev, int ix, int iy, int ieta,
@@ -43,12 +57,26 @@ class Advance {
                       VelocityShearVec &sigma_local, DmuMuBoverTVec &baryon_diffusion_vector, int ieta, int ix, int iy);
 
     void UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt);
+
+    //! counters of the reconstruction since the last reset
+    ReconstStats get_reconst_statistics() const {
+        return(reconst_helper.get_statistics());
+    }
+    void reset_reconst_statistics() {reconst_helper.reset_statistics();}
     void QuestRevert(double tau, Cell_small *grid_pt, int ieta, int ix, int iy);
     void QuestRevert_qmu(double tau, Cell_small *grid_pt,
                          int ieta, int ix, int iy);
 
     void MakeDeltaQI(double tau, SCGrid &arena_current,
                      int ix, int iy, int ieta, TJbVec &qi, int rk_flag);
+    void MakeFaceFluxes(double tau, SCGrid &arena_current);
+    void MakeFaceStates(double tau, SCGrid &arena_current, int direction,
+                        int iy, int ieta, int n_faces, double *stencil,
+                        TJbVec *q_face, const Cell_small* *ref_cells);
+    void MakeFaceFlux(double tau, int direction,
+                      const TJbVec &qL, const TJbVec &qR,
+                      const ReconstCell &grid_L, const ReconstCell &grid_R,
+                      TJbVec &flux);
     double MaxSpeed(double tau, int direc, const ReconstCell &grid_p);
     double get_TJb(const ReconstCell &grid_p, const int rk_flag, const int mu, const int nu);
     double get_TJb(const Cell_small &grid_p, const int mu, const int nu);
@@ -11,8 +11,8 @@ class Cell_small {
     double rhob    = 0;
     FlowVec u;
 
-    ViscousVec Wmunu;
-    double pi_b    = 0.;
+    ViscousStorageVec Wmunu;
+    DissStorage pi_b = 0.;
 };
 
 #endif  // SRC_GRID_H_
@@ -32,6 +32,9 @@ typedef struct init_data {
     std::string initName_rhob_TA;
     std::string initName_rhob_TB;
     std::string initName_AMPT;
+    //! precision of the binary initial-condition files written in running
+    //! mode 74, 4 (float) or 8 (double) bytes
+    int initial_condition_binary_precision;
 
     //! random seed
     int seed;
@@ -73,11 +76,30 @@ typedef struct init_data {
     double delta_eta;
     double delta_tau;
 
+    //! order of the Runge-Kutta scheme (1, 2 or 3), see rk_scheme.h
     int rk_order;
     double minmod_theta;
+    //! 0: every cell computes the KT fluxes at both of its faces,
+    //! 1: every face flux is computed once and shared by the two cells
+    int flux_sweep_mode;
+    //! initial guess of the Newton iterations in the reconstruction,
+    //! 0: previous velocity, 1: extrapolated velocity, 2: EoS table
+    int reconst_initial_guess;
+    //! number of cells in eta per slab for the temporal blocking of the
+    //! Runge-Kutta stages (0: every stage sweeps the full grid)
+    int temporal_blocking_slab;
+    //! 1: pin the OpenMP threads to cpus during the hydro run
+    int omp_thread_binding;
 
     double sFactor;     //!< overall normalization on energy density profile
     int whichEOS;       //!< type of EoS
+    //! interpolation in the EoS tables, 1: linear, 3: monotone cubic
+    int eos_interpolation_order;
+    //! relative tolerance for resampling the EoS tables (0: no resampling)
+    double eos_resample_tolerance;
+    //! 1: tabulate dP/de, dP/drhob and cs^2 at the EoS table nodes,
+    //! 0: finite differences of the pressure
+    int eos_derivative_tables;
     //! flag for boost invariant simulations
     bool boost_invariant;
 
@@ -134,6 +156,10 @@ typedef struct init_data {
     double shear_relax_time_factor;
     double bulk_relax_time_factor;
 
+    //! if 1, eta/s(T) and zeta/s(T) are tabulated at start-up and
+    //! linearly interpolated during the evolution
+    int transport_coeffs_table;
+
     //! flag to include second order non-linear coupling terms
     int include_second_order_terms;
 
@@ -143,8 +169,23 @@ typedef struct init_data {
     //! decide whether to output the evolution data (1) or not (0)
     int outputEvolutionData;
 
+    //! prefix of all the output files, "" for the current directory or a
+    //! directory name ending with '/'
+    std::string output_directory;
+
+    //! file with one initial-condition file per line for the ensemble
+    //! run, "" for a single event
+    std::string ensemble_event_list;
+
+    //! number of ensemble events evolved at the same time, the OpenMP
+    //! threads are split evenly between them
+    int ensemble_concurrent_events;
+
     //! flag to store hydro evolution in memory for jetscape
     int store_hydro_info_in_memory;
+    //! bytes per value of the hydro evolution stored in memory,
+    //! 4 (float) or 2 (IEEE half precision)
+    int store_hydro_info_precision;
 
     //! decide whether to output files for movie
     int output_movie_flag;
@@ -2,6 +2,7 @@
 #define _SRC_DATA_STRUCT_H_
 
 #include <array>
+#include <cstddef>
 
 typedef std::array<std::array<double, 4>, 4> Mat4x4;
 typedef std::array<double, 10>               Arr10;
@@ -13,6 +14,16 @@ typedef std::array<double, 5>  DumuVec;
 typedef Arr10                  VelocityShearVec;
 typedef std::array<double, 4>  DmuMuBoverTVec;
 typedef std::array<double, 14> ViscousVec;
+
+//! storage type of the dissipative fields in Cell_small. The kernels
+//! compute in double precision in either case; with the CMake option
+//! mixed_precision the grid keeps W^{mu nu} and Pi in single precision
+#ifdef MUSIC_MIXED_PRECISION
+typedef float  DissStorage;
+#else
+typedef double DissStorage;
+#endif
+typedef std::array<DissStorage, 14> ViscousStorageVec;
 typedef std::array<std::array<double, 4>, 5> dUsupMat;
 
 typedef struct {
@@ -34,6 +45,31 @@ typedef struct {
     float ux, uy, ueta;
 } fluidCell_ideal;
 
+//! The pre-equilibrium fields handed over by the JETSCAPE framework. The
+//! pointers refer to buffers of n_cells values owned by the caller, which
+//! are read in place while the grid is initialized. The cell index is
+//! ieta + iy*neta + ix*ny*neta. e and u^mu are required, a viscous field
+//! left as nullptr starts at zero
+struct PreequilibriumFields {
+    size_t n_cells = 0;
+    const double *e       = nullptr;  //!< GeV/fm^3
+    const double *u_tau   = nullptr;
+    const double *u_x     = nullptr;
+    const double *u_y     = nullptr;
+    const double *u_eta   = nullptr;  //!< 1/fm
+    const double *pi_00   = nullptr;  //!< GeV/fm^3, 1/fm more per eta index
+    const double *pi_01   = nullptr;
+    const double *pi_02   = nullptr;
+    const double *pi_03   = nullptr;
+    const double *pi_11   = nullptr;
+    const double *pi_12   = nullptr;
+    const double *pi_13   = nullptr;
+    const double *pi_22   = nullptr;
+    const double *pi_23   = nullptr;
+    const double *pi_33   = nullptr;
+    const double *bulk_pi = nullptr;  //!< GeV/fm^3
+};
+
 template<typename T>
 T assume_aligned(T x) {
   #if defined(__AVX512__)
@@ -24,7 +24,7 @@ Diss::Diss(const EOS &eosIn, const InitData &Data_in)
 for everywhere else. also, this change is necessary
 to use Wmunu[rk_flag][4][mu] as the dissipative baryon current*/
 /* this is the only one that is being subtracted in the rhs */
-void Diss::MakeWSource(const double tau,
+void Diss::MakeWSource(const double tau, const double delta_tau_prev,
                        SCGrid &arena_current, SCGrid &arena_prev,
                        const int ix, const int iy, const int ieta,
                        TJbVec &dwmn) {
@@ -52,7 +52,7 @@ void Diss::MakeWSource(const double tau,
         // backward time derivative (first order is more stable)
         int idx_1d_alpha0 = map_2d_idx_to_1d(alpha, 0);
         double dWdtau = (grid_pt.Wmunu[idx_1d_alpha0]
-                         - grid_pt_prev.Wmunu[idx_1d_alpha0])/DATA.delta_tau;
+                         - grid_pt_prev.Wmunu[idx_1d_alpha0])/delta_tau_prev;
 
         /* bulk pressure term */
         double dPidtau = 0.0;
@@ -63,7 +63,7 @@ void Diss::MakeWSource(const double tau,
             dPidtau = ((Pi_alpha0 - grid_pt_prev.pi_b
                                     *(gfac + grid_pt_prev.u[alpha]
                                              *grid_pt_prev.u[0]))
-                       /DATA.delta_tau);
+                       /delta_tau_prev);
         }
 
         double dWdx  = 0.0;  // partial_i (tau W^{i \alpha})
@@ -150,26 +150,50 @@ void Diss::MakeWSource(const double tau,
     //dwmn[3] += grid_pt.pi_b*(grid_pt.u[0]*grid_pt.u[3]);
 }
 
-double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
-                           int mu, int nu, int rk_flag, double theta_local,
-                           DumuVec &a_local, VelocityShearVec &sigma_1d) {
+//! This function computes the source terms of all the dissipative
+//! quantities of the cell. The thermodynamic quantities are looked up once
+//! and shared by the shear, bulk and diffusion parts.
+//! w_source[4-8] and w_source[11-13] are the sources of the independent
+//! shear and diffusion components, pi_source the source of the bulk pressure.
+//! grid_pt is the Runge-Kutta stage state at tau
+void Diss::Make_uWSource(const double tau, const Cell_small *grid_pt,
+                         const double theta_local, const DumuVec &a_local,
+                         const VelocityShearVec &sigma_1d,
+                         const DmuMuBoverTVec &baryon_diffusion_vec,
+                         ViscousVec &w_source, double &pi_source) {
+    const double epsilon  = grid_pt->epsilon;
+    const double rhob     = grid_pt->rhob;
+    const double T        = eos.get_temperature(epsilon, rhob);
+    const double pressure = eos.get_pressure(epsilon, rhob);
+
+    if (DATA.turn_on_shear == 1) {
+        Make_uWSource_shear(grid_pt, epsilon, pressure, T, theta_local,
+                            sigma_1d, w_source);
+    }
+    if (DATA.turn_on_bulk == 1) {
+        pi_source = Make_uPiSource(grid_pt, epsilon, rhob, pressure, T,
+                                   theta_local, sigma_1d);
+    }
+    if (DATA.turn_on_diff == 1) {
+        Make_uqSource(tau, grid_pt, epsilon, rhob, pressure, T, theta_local,
+                      a_local, sigma_1d, baryon_diffusion_vec, w_source);
+    }
+}
+
+
+//! shear part of Make_uWSource, for the components w_source[4-8]
+void Diss::Make_uWSource_shear(const Cell_small *grid_pt,
+                               const double epsilon, const double pressure,
+                               const double T, const double theta_local,
+                               const VelocityShearVec &sigma_1d,
+                               ViscousVec &w_source) {
     double tempf;
-    double SW, shear, shear_to_s, T, epsilon, rhob;
+    double SW, shear, shear_to_s;
     double NS_term;
 
     auto sigma = Util::UnpackVecToMatrix(sigma_1d);
     auto Wmunu = Util::UnpackVecToMatrix(grid_pt->Wmunu);
 
-    if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
-    } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
-    }
-
-    T = eos.get_temperature(epsilon, rhob);
-
     shear_to_s = transport_coeffs_.get_eta_over_s(T);
 
     int include_WWterm         = 0;
@@ -185,7 +209,6 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
     //                Defining transport coefficients                     //
     ////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////
-    double pressure = eos.get_pressure(epsilon, rhob);
     shear = (shear_to_s)*(epsilon + pressure)/(T + 1e-15);
     double tau_pi = (transport_coeffs_.get_shear_relax_time_factor()
                      *shear/(epsilon + pressure + 1e-15));
@@ -208,87 +231,11 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
     double transport_coefficient2_b = 0.;
 
 
-    /* This source has many terms */
-    /* everything in the 1/(tau_pi) piece is here */
-    /* third step in the split-operator time evol 
-       use Wmunu[rk_flag] and u[rk_flag] with rk_flag = 0 */
-
-    ////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////
-    //           Wmunu + transport_coefficient2*Wmunu*theta               //
-    ////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////
-
-    // full term is
-    tempf = (-(1.0 + transport_coefficient2*theta_local)*(Wmunu[mu][nu]));
-
-    /////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////
-    //           Navier-Stokes Term -- -2.*shear*sigma^munu                //
-    /////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////
-
-    // full Navier-Stokes term is
-    // sign changes according to metric sign convention
-    NS_term = - 2.*shear*sigma[mu][nu];
-
-    /////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////
-    //                            Vorticity Term                           //
-    /////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////
-    double Vorticity_term = 0.0;
-    // if (include_Vorticity_term == 1) {
-    //     double transport_coefficient4 = 2.*tau_pi;
-    //     double omega[4][4];
-    //     double gmunu[4][4] = {{-1., 0., 0., 0.},
-    //                           { 0., 1., 0., 0.},
-    //                           { 0., 0., 1., 0.},
-    //                           { 0., 0., 0., 1.}};
-    //     double gamma = grid_pt->u[0];
-    //     double ueta  = grid_pt->u[3];
-    //     for (int a = 0; a < 4; a++) {
-    //         for (int b = 0; b < 4; b++) {
-    //             omega[a][b] = (
-    //                 (grid_pt->dUsup[a][b]
-    //                  - grid_pt->dUsup[b][a])/2.
-    //                 + ueta/tau/2.*(  gmunu[a][0]*gmunu[b][3]
-    //                                - gmunu[b][0]*gmunu[a][3])
-    //                 - ueta*gamma/tau/2.
-    //                   *(  gmunu[a][3]*grid_pt->u[b]
-    //                     - gmunu[b][3]*grid_pt->u[a])
-    //                 + ueta*ueta/tau/2.
-    //                   *(   gmunu[a][0]*grid_pt->u[b]
-    //                      - gmunu[b][0]*grid_pt->u[a])
-    //                 + (  grid_pt->u[a]*a_local[b]
-    //                    - grid_pt->u[b]*a_local[a])/2.);
-    //         }
-    //     }
-    //     double term1_Vorticity = (- Wmunu[mu][0]*omega[nu][0]
-    //                               - Wmunu[nu][0]*omega[mu][0]
-    //                               + Wmunu[mu][1]*omega[nu][1]
-    //                               + Wmunu[nu][1]*omega[mu][1]
-    //                               + Wmunu[mu][2]*omega[nu][2]
-    //                               + Wmunu[nu][2]*omega[mu][2]
-    //                               + Wmunu[mu][3]*omega[nu][3]
-    //                               + Wmunu[nu][3]*omega[mu][3])/2.;
-    //     // multiply term by its respective transport coefficient
-    //     term1_Vorticity = transport_coefficient4*term1_Vorticity;
-    //     // full term is
-    //     Vorticity_term = term1_Vorticity;
-    // } else {
-    //     Vorticity_term = 0.0;
-    // }
-
-    ///////////////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////////////
-    //                  Add nonlinear term in shear-stress tensor                //
-    //  transport_coefficient3*Delta(mu nu)(alpha beta)*Wmu gamma sigma nu gamma //
-    ///////////////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////////////
-    double Wsigma_term = 0.0;
+    // the contractions W^{ab} sigma_{ab} and W^{ab} W_{ab} are the same
+    // for all components
+    double Wsigma = 0.0;
     if (include_Wsigma_term == 1) {
-        double Wsigma = (
+        Wsigma = (
                Wmunu[0][0]*sigma[0][0]
              + Wmunu[1][1]*sigma[1][1]
              + Wmunu[2][2]*sigma[2][2]
@@ -299,98 +246,192 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
              +2.*(  Wmunu[1][2]*sigma[1][2]
                   + Wmunu[1][3]*sigma[1][3]
                   + Wmunu[2][3]*sigma[2][3]));
-        double term1_Wsigma = ( - Wmunu[mu][0]*sigma[nu][0]
-                                - Wmunu[nu][0]*sigma[mu][0]
-                                + Wmunu[mu][1]*sigma[nu][1]
-                                + Wmunu[nu][1]*sigma[mu][1]
-                                + Wmunu[mu][2]*sigma[nu][2]
-                                + Wmunu[nu][2]*sigma[mu][2]
-                                + Wmunu[mu][3]*sigma[nu][3]
-                                + Wmunu[nu][3]*sigma[mu][3])/2.;
-
-        double term2_Wsigma = (-(1./3.)*(DATA.gmunu[mu][nu]
-                                         + grid_pt->u[mu]
-                                           *grid_pt->u[nu])*Wsigma);
-        // multiply term by its respective transport coefficient
-        term1_Wsigma = transport_coefficient3*term1_Wsigma;
-        term2_Wsigma = transport_coefficient3*term2_Wsigma;
-
-        // full term is
-        Wsigma_term = -term1_Wsigma - term2_Wsigma;
     }
-
-    //////////////////////////////////////////////////////////////////////////
-    //////////////////////////////////////////////////////////////////////////
-    //              Add nonlinear term in shear-stress tensor               //
-    //  transport_coefficient*Delta(mu nu)(alpha beta)*Wmu gamma Wnu gamma  //
-    //////////////////////////////////////////////////////////////////////////
-    //////////////////////////////////////////////////////////////////////////
-    double WW_term = 0.0;
+    double Wsquare = 0.0;
     if (include_WWterm == 1) {
-        double Wsquare = (  Wmunu[0][0]*Wmunu[0][0]
-                          + Wmunu[1][1]*Wmunu[1][1]
-                          + Wmunu[2][2]*Wmunu[2][2]
-                          + Wmunu[3][3]*Wmunu[3][3]
-                   - 2.*(  Wmunu[0][1]*Wmunu[0][1]
-                         + Wmunu[0][2]*Wmunu[0][2]
-                         + Wmunu[0][3]*Wmunu[0][3])
-                   + 2.*(  Wmunu[1][2]*Wmunu[1][2]
-                         + Wmunu[1][3]*Wmunu[1][3]
-                         + Wmunu[2][3]*Wmunu[2][3]));
-        double term1_WW = ( - Wmunu[mu][0]*Wmunu[nu][0]
-                            + Wmunu[mu][1]*Wmunu[nu][1]
-                            + Wmunu[mu][2]*Wmunu[nu][2]
-                            + Wmunu[mu][3]*Wmunu[nu][3]);
-        double term2_WW = (-(1./3.)*(DATA.gmunu[mu][nu]
-                                     + grid_pt->u[mu]*grid_pt->u[nu])*Wsquare);
+        Wsquare = (  Wmunu[0][0]*Wmunu[0][0]
+                   + Wmunu[1][1]*Wmunu[1][1]
+                   + Wmunu[2][2]*Wmunu[2][2]
+                   + Wmunu[3][3]*Wmunu[3][3]
+            - 2.*(  Wmunu[0][1]*Wmunu[0][1]
+                  + Wmunu[0][2]*Wmunu[0][2]
+                  + Wmunu[0][3]*Wmunu[0][3])
+            + 2.*(  Wmunu[1][2]*Wmunu[1][2]
+                  + Wmunu[1][3]*Wmunu[1][3]
+                  + Wmunu[2][3]*Wmunu[2][3]));
+    }
 
-        // multiply term by its respective transport coefficient
-        term1_WW = term1_WW*transport_coefficient;
-        term2_WW = term2_WW*transport_coefficient;
+    for (int idx_1d = 4; idx_1d < 9; idx_1d++) {
+        int mu = 0;
+        int nu = 0;
+        Util::map_1d_idx_to_2d(idx_1d, mu, nu);
+
+        /* This source has many terms */
+        /* everything in the 1/(tau_pi) piece is here */
+        /* third step in the split-operator time evol 
+           use Wmunu[rk_flag] and u[rk_flag] with rk_flag = 0 */
+
+        ////////////////////////////////////////////////////////////////////////
+        ////////////////////////////////////////////////////////////////////////
+        //           Wmunu + transport_coefficient2*Wmunu*theta               //
+        ////////////////////////////////////////////////////////////////////////
+        ////////////////////////////////////////////////////////////////////////
 
         // full term is
+        tempf = (-(1.0 + transport_coefficient2*theta_local)*(Wmunu[mu][nu]));
+
+        /////////////////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////////////////
+        //           Navier-Stokes Term -- -2.*shear*sigma^munu                //
+        /////////////////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////////////////
+
+        // full Navier-Stokes term is
         // sign changes according to metric sign convention
-        WW_term = -term1_WW - term2_WW;
-    }
+        NS_term = - 2.*shear*sigma[mu][nu];
+
+        /////////////////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////////////////
+        //                            Vorticity Term                           //
+        /////////////////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////////////////
+        double Vorticity_term = 0.0;
+        // if (include_Vorticity_term == 1) {
+        //     double transport_coefficient4 = 2.*tau_pi;
+        //     double omega[4][4];
+        //     double gmunu[4][4] = {{-1., 0., 0., 0.},
+        //                           { 0., 1., 0., 0.},
+        //                           { 0., 0., 1., 0.},
+        //                           { 0., 0., 0., 1.}};
+        //     double gamma = grid_pt->u[0];
+        //     double ueta  = grid_pt->u[3];
+        //     for (int a = 0; a < 4; a++) {
+        //         for (int b = 0; b < 4; b++) {
+        //             omega[a][b] = (
+        //                 (grid_pt->dUsup[a][b]
+        //                  - grid_pt->dUsup[b][a])/2.
+        //                 + ueta/tau/2.*(  gmunu[a][0]*gmunu[b][3]
+        //                                - gmunu[b][0]*gmunu[a][3])
+        //                 - ueta*gamma/tau/2.
+        //                   *(  gmunu[a][3]*grid_pt->u[b]
+        //                     - gmunu[b][3]*grid_pt->u[a])
+        //                 + ueta*ueta/tau/2.
+        //                   *(   gmunu[a][0]*grid_pt->u[b]
+        //                      - gmunu[b][0]*grid_pt->u[a])
+        //                 + (  grid_pt->u[a]*a_local[b]
+        //                    - grid_pt->u[b]*a_local[a])/2.);
+        //         }
+        //     }
+        //     double term1_Vorticity = (- Wmunu[mu][0]*omega[nu][0]
+        //                               - Wmunu[nu][0]*omega[mu][0]
+        //                               + Wmunu[mu][1]*omega[nu][1]
+        //                               + Wmunu[nu][1]*omega[mu][1]
+        //                               + Wmunu[mu][2]*omega[nu][2]
+        //                               + Wmunu[nu][2]*omega[mu][2]
+        //                               + Wmunu[mu][3]*omega[nu][3]
+        //                               + Wmunu[nu][3]*omega[mu][3])/2.;
+        //     // multiply term by its respective transport coefficient
+        //     term1_Vorticity = transport_coefficient4*term1_Vorticity;
+        //     // full term is
+        //     Vorticity_term = term1_Vorticity;
+        // } else {
+        //     Vorticity_term = 0.0;
+        // }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        ///////////////////////////////////////////////////////////////////////////////
+        //                  Add nonlinear term in shear-stress tensor                //
+        //  transport_coefficient3*Delta(mu nu)(alpha beta)*Wmu gamma sigma nu gamma //
+        ///////////////////////////////////////////////////////////////////////////////
+        ///////////////////////////////////////////////////////////////////////////////
+        double Wsigma_term = 0.0;
+        if (include_Wsigma_term == 1) {
+            double term1_Wsigma = ( - Wmunu[mu][0]*sigma[nu][0]
+                                    - Wmunu[nu][0]*sigma[mu][0]
+                                    + Wmunu[mu][1]*sigma[nu][1]
+                                    + Wmunu[nu][1]*sigma[mu][1]
+                                    + Wmunu[mu][2]*sigma[nu][2]
+                                    + Wmunu[nu][2]*sigma[mu][2]
+                                    + Wmunu[mu][3]*sigma[nu][3]
+                                    + Wmunu[nu][3]*sigma[mu][3])/2.;
+
+            double term2_Wsigma = (-(1./3.)*(DATA.gmunu[mu][nu]
+                                             + grid_pt->u[mu]
+                                               *grid_pt->u[nu])*Wsigma);
+            // multiply term by its respective transport coefficient
+            term1_Wsigma = transport_coefficient3*term1_Wsigma;
+            term2_Wsigma = transport_coefficient3*term2_Wsigma;
+
+            // full term is
+            Wsigma_term = -term1_Wsigma - term2_Wsigma;
+        }
 
-    //////////////////////////////////////////////////////////////////////////
-    //////////////////////////////////////////////////////////////////////////
-    //              Add coupling to bulk viscous pressure                   //
-    //             transport_coefficient_b*Bulk*sigma^mu nu                 //
-    //              transport_coefficient2_b*Bulk*W^mu nu                   //
-    //////////////////////////////////////////////////////////////////////////
-    //////////////////////////////////////////////////////////////////////////
-    double Coupling_to_Bulk = 0.0;
-    if (DATA.include_second_order_terms == 1) {
-        double Bulk_Sigma = grid_pt->pi_b*sigma[mu][nu];
-        double Bulk_W = grid_pt->pi_b*Wmunu[mu][nu];
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        //              Add nonlinear term in shear-stress tensor               //
+        //  transport_coefficient*Delta(mu nu)(alpha beta)*Wmu gamma Wnu gamma  //
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        double WW_term = 0.0;
+        if (include_WWterm == 1) {
+            double term1_WW = ( - Wmunu[mu][0]*Wmunu[nu][0]
+                                + Wmunu[mu][1]*Wmunu[nu][1]
+                                + Wmunu[mu][2]*Wmunu[nu][2]
+                                + Wmunu[mu][3]*Wmunu[nu][3]);
+            double term2_WW = (-(1./3.)*(DATA.gmunu[mu][nu]
+                                         + grid_pt->u[mu]*grid_pt->u[nu])*Wsquare);
+
+            // multiply term by its respective transport coefficient
+            term1_WW = term1_WW*transport_coefficient;
+            term2_WW = term2_WW*transport_coefficient;
+
+            // full term is
+            // sign changes according to metric sign convention
+            WW_term = -term1_WW - term2_WW;
+        }
 
-        // multiply term by its respective transport coefficient
-        double Bulk_Sigma_term = Bulk_Sigma*transport_coefficient_b;
-        double Bulk_W_term = Bulk_W*transport_coefficient2_b;
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        //              Add coupling to bulk viscous pressure                   //
+        //             transport_coefficient_b*Bulk*sigma^mu nu                 //
+        //              transport_coefficient2_b*Bulk*W^mu nu                   //
+        //////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////
+        double Coupling_to_Bulk = 0.0;
+        if (DATA.include_second_order_terms == 1) {
+            double Bulk_Sigma = grid_pt->pi_b*sigma[mu][nu];
+            double Bulk_W = grid_pt->pi_b*Wmunu[mu][nu];
+
+            // multiply term by its respective transport coefficient
+            double Bulk_Sigma_term = Bulk_Sigma*transport_coefficient_b;
+            double Bulk_W_term = Bulk_W*transport_coefficient2_b;
+
+            // full term is
+            // first term: sign changes according to metric sign convention
+            Coupling_to_Bulk = -Bulk_Sigma_term + Bulk_W_term;
+        }
 
-        // full term is
-        // first term: sign changes according to metric sign convention
-        Coupling_to_Bulk = -Bulk_Sigma_term + Bulk_W_term;
+        // final answer is
+        SW = (NS_term + tempf + Vorticity_term + Wsigma_term + WW_term
+              + Coupling_to_Bulk)/(tau_pi);
+        w_source[idx_1d] = SW;
     }
-
-    // final answer is
-    SW = (NS_term + tempf + Vorticity_term + Wsigma_term + WW_term
-          + Coupling_to_Bulk)/(tau_pi);
-    return(SW);
 }
 
 
-int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
-                     int mu, int nu, double &w_rhs,
-                     double theta_local, DumuVec &a_local) {
+//! This function computes the right-hand side of the evolution equations
+//! of all the dissipative quantities of the cell: the KT fluxes of
+//! u^i W^{mu nu}, u^i Pi and u^i q^mu, and the local geometric terms.
+//! The stencil is gathered in one Neighbourloop for all the components.
+//! w_rhs[4-8] and w_rhs[11-13] are for the independent shear and diffusion
+//! components, p_rhs for the bulk pressure
+void Diss::Make_uWRHS(const double tau, SCGrid &arena,
+                      const int ix, const int iy, const int ieta,
+                      const double theta_local, const DumuVec &a_local,
+                      ViscousVec &w_rhs, double &p_rhs) {
     const InitData *const DATAaligned = assume_aligned(&DATA);
     auto& grid_pt = arena(ix, iy, ieta);
 
-    w_rhs = 0.;
-
-    auto Wmunu_local = Util::UnpackVecToMatrix(grid_pt.Wmunu);
-
     /* Kurganov-Tadmor for Wmunu */
     /* implement 
        partial_tau (utau Wmn) + (1/tau)partial_eta (ueta Wmn) 
@@ -407,210 +448,196 @@ int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
        Here fRph = ux WmnRph and ax uRph = |ux/utau|_max utau Wmn */
     /* This is the second step in the operator splitting. it uses
        rk_flag+1 as initial condition */
+    /* the same for Pi and q^mu */
     double delta[4] = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta*tau};
 
     const double delta_tau = DATA.delta_tau;
 
-    // pi^\mu\nu is symmetric
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        int idx_1d = map_2d_idx_to_1d(mu, nu);
-        double sum = 0.0;
-        /* Get_uWmns */
-        double g = c.Wmunu[idx_1d];
-        double f = g*c.u[direction];
-        g *=   c.u[0];
-
-        double gp2 = p2.Wmunu[idx_1d];
-        double fp2 = gp2*p2.u[direction];
-        gp2 *= p2.u[0];
-
-        double gp1 = p1.Wmunu[idx_1d];
-        double fp1 = gp1*p1.u[direction];
-        gp1 *= p1.u[0];
-
-        double gm1 = m1.Wmunu[idx_1d];
-        double fm1 = gm1*m1.u[direction];
-        gm1 *= m1.u[0];
-
-        double gm2 = m2.Wmunu[idx_1d];
-        double fm2 = gm2*m2.u[direction];
-        gm2 *= m2.u[0];
-
-        /* MakeuWmnHalfs */
-        /* uWmn */
-        double uWphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp  = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uWphL = f + temp;
-        double uWmhR = f - temp;
-        double uWmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Wmn */
-        double WphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp        = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double WphL = g + temp;
-        double WmhR = g - temp;
-        double WmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
+    // the components that are evolved
+    int idx_list[8];
+    int n_idx = 0;
+    if (DATA.turn_on_shear == 1) {
+        for (int idx_1d = 4; idx_1d < 9; idx_1d++) idx_list[n_idx++] = idx_1d;
+    }
+    if (DATA.turn_on_diff == 1) {
+        for (int idx_1d = 11; idx_1d < 14; idx_1d++) idx_list[n_idx++] = idx_1d;
+    }
+    const bool flag_bulk = (DATA.turn_on_bulk == 1);
 
+    for (int i = 0; i < n_idx; i++) w_rhs[idx_list[i]] = 0.;
+    double q_sum[4]  = {0.};
+    double pi_sum    = 0.;
+    const int n_comp = n_idx + (flag_bulk ? 1 : 0);
+
+    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
         double a   = fabs(c.u[direction])/c.u[0];
         double am1 = (fabs(m1.u[direction])/m1.u[0]);
         double ap1 = (fabs(p1.u[direction])/p1.u[0]);
-
-        double ax = std::max(a, ap1);
-        double HWph = ((uWphR + uWphL) - ax*(WphR - WphL))*0.5;
-
-        ax = std::max(a, am1);
-        double HWmh = ((uWmhR + uWmhL) - ax*(WmhR - WmhL))*0.5;
-
-        double HW = (HWph - HWmh)/delta[direction];
-
-        /* make partial_i (u^i Wmn) */
-        sum += -HW;
-
-        w_rhs += sum*delta_tau;
+        double ax_ph = std::max(a, ap1);
+        double ax_mh = std::max(a, am1);
+
+        // partial_i (u^i X) for the KT scheme, X = W^{mu nu}, Pi, or q^mu.
+        // The stencils of f = u^i X and g = u^tau X of all the components
+        // are gathered in six blocks of n_comp values, so that all their
+        // slopes are limited by one call of the vectorized minmod
+        double up1[6*9], u[6*9], um1[6*9], slope[6*9];
+        for (int k = 0; k < n_comp; k++) {
+            double Xc, Xp1, Xp2, Xm1, Xm2;
+            if (k < n_idx) {
+                const int idx_1d = idx_list[k];
+                Xc  = c.Wmunu[idx_1d];
+                Xp1 = p1.Wmunu[idx_1d];
+                Xp2 = p2.Wmunu[idx_1d];
+                Xm1 = m1.Wmunu[idx_1d];
+                Xm2 = m2.Wmunu[idx_1d];
+            } else {
+                Xc  = c.pi_b;
+                Xp1 = p1.pi_b;
+                Xp2 = p2.pi_b;
+                Xm1 = m1.pi_b;
+                Xm2 = m2.pi_b;
+            }
+            const double f   = Xc*c.u[direction];
+            const double fp2 = Xp2*p2.u[direction];
+            const double fp1 = Xp1*p1.u[direction];
+            const double fm1 = Xm1*m1.u[direction];
+            const double fm2 = Xm2*m2.u[direction];
+            const double g   = Xc*c.u[0];
+            const double gp2 = Xp2*p2.u[0];
+            const double gp1 = Xp1*p1.u[0];
+            const double gm1 = Xm1*m1.u[0];
+            const double gm2 = Xm2*m2.u[0];
+
+            up1[k]              = fp2;
+            u[k]                = fp1;
+            um1[k]              = f;
+            up1[n_comp + k]     = fp1;
+            u[n_comp + k]       = f;
+            um1[n_comp + k]     = fm1;
+            up1[2*n_comp + k]   = f;
+            u[2*n_comp + k]     = fm1;
+            um1[2*n_comp + k]   = fm2;
+            up1[3*n_comp + k]   = gp2;
+            u[3*n_comp + k]     = gp1;
+            um1[3*n_comp + k]   = g;
+            up1[4*n_comp + k]   = gp1;
+            u[4*n_comp + k]     = g;
+            um1[4*n_comp + k]   = gm1;
+            up1[5*n_comp + k]   = g;
+            u[5*n_comp + k]     = gm1;
+            um1[5*n_comp + k]   = gm2;
+        }
+        minmod.minmod_dx(up1, u, um1, slope, 6*n_comp);
+
+        for (int k = 0; k < n_comp; k++) {
+            const double f   = u[n_comp + k];
+            const double fp1 = u[k];
+            const double fm1 = u[2*n_comp + k];
+            const double g   = u[4*n_comp + k];
+            const double gp1 = u[3*n_comp + k];
+            const double gm1 = u[5*n_comp + k];
+
+            /* MakeuWmnHalfs */
+            /* uWmn */
+            double uWphR = fp1 - 0.5*slope[k];
+            double temp  = 0.5*slope[n_comp + k];
+            double uWphL = f + temp;
+            double uWmhR = f - temp;
+            double uWmhL = fm1 + 0.5*slope[2*n_comp + k];
+
+            /* just Wmn */
+            double WphR = gp1 - 0.5*slope[3*n_comp + k];
+            temp        = 0.5*slope[4*n_comp + k];
+            double WphL = g + temp;
+            double WmhR = g - temp;
+            double WmhL = gm1 + 0.5*slope[5*n_comp + k];
+
+            double HWph = ((uWphR + uWphL) - ax_ph*(WphR - WphL))*0.5;
+            double HWmh = ((uWmhR + uWmhL) - ax_mh*(WmhR - WmhL))*0.5;
+            const double HW = (HWph - HWmh)/delta[direction];
+
+            if (k == n_idx) {
+                /* make partial_i (u^i Pi) */
+                pi_sum += -HW;
+                continue;
+            }
+            const int idx_1d = idx_list[k];
+            /* make partial_i (u^i Wmn) */
+            if (idx_1d < 10) {
+                w_rhs[idx_1d] += -HW*delta_tau;
+            } else {
+                q_sum[idx_1d - 10] += -HW;
+            }
+        }
     });
 
-    /* add a source term -u^tau Wmn/tau
-       due to the coordinate change to tau-eta */
-    /* this is from udW = d(uW) - Wdu = RHS */
-    /* or d(uW) = udW + Wdu */
-    /* this term is being added to the rhs so that -4/3 + 1 = -1/3 */
-    /* other source terms due to the coordinate change to tau-eta */
-
-    // align gmunu in data for faster access - also changed **gmunu in data to gmunu[4][4]
-    // moved two sums into w_rhs at top and bottom into one sum in the end
-    // do not symmetrize in the end, just go through all nu's
-    // vectorized innermost loop more efficiently by iterating over 4 indices instead of 3 to avoid masking
-
-    double tempf = (
-          //   - (((init_data*)(&mydata))->gmunu[3][mu])*(Wmunu_local[0][nu]) //TODO: Ask Bjorn about this
-         - (DATAaligned->gmunu[3][mu])*(Wmunu_local[0][nu])
-         - (DATAaligned->gmunu[3][nu])*(Wmunu_local[0][mu])
-         + (DATAaligned->gmunu[0][mu])*(Wmunu_local[3][nu])
-         + (DATAaligned->gmunu[0][nu])*(Wmunu_local[3][mu])
-         + (Wmunu_local[3][nu])
-         *(grid_pt.u[mu])*(grid_pt.u[0])
-         + (Wmunu_local[3][mu])
-         *(grid_pt.u[nu])*(grid_pt.u[0])
-         - (Wmunu_local[0][nu])
-         *(grid_pt.u[mu])*(grid_pt.u[3])
-         - (Wmunu_local[0][mu])
-         *(grid_pt.u[nu])*(grid_pt.u[3]))*(grid_pt.u[3]/tau);
-
-    for (int ic = 0; ic < 4; ic++) {
-        const double ic_fac = (ic == 0 ? -1.0 : 1.0);
-        tempf += (
-            (Wmunu_local[ic][nu])*(grid_pt.u[mu])
-            *(a_local[ic])*ic_fac
-            + (Wmunu_local[ic][mu])*(grid_pt.u[nu])
-            *(a_local[ic])*ic_fac);
-    }
-
-    w_rhs += (tempf*(DATAaligned->delta_tau)
-              + (- (grid_pt.u[0]*Wmunu_local[mu][nu])/tau
-                 + (theta_local*Wmunu_local[mu][nu]))*(DATAaligned->delta_tau));
-    return(1);
-}
-
-
-int Diss::Make_uPRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
-                     double *p_rhs, double theta_local) {
-    auto grid_pt = &(arena(ix, iy, ieta));
-
-    /* Kurganov-Tadmor for Pi */
-    /* implement 
-      partial_tau (utau Pi) + (1/tau)partial_eta (ueta Pi) 
-      + partial_x (ux Pi) + partial_y (uy Pi) + utau Pi/tau = SP 
-      or the right hand side of
-      partial_tau (utau Pi) = -
-      (1/tau)partial_eta (ueta Pi) - partial_x (ux Pi) - partial_y (uy Pi)
-      - utau Pi/tau + SP 
-      */
-
-    /* the local velocity is just u_x/u_tau, u_y/u_tau, u_eta/tau/u_tau */
-    /* KT flux is given by 
-       H_{j+1/2} = (fRph + fLph)/2 - ax(uRph - uLph) 
-       Here fRph = ux PiRph and ax uRph = |ux/utau|_max utau Pin */
-
-    /* This is the second step in the operator splitting. it uses
-       rk_flag+1 as initial condition */
-
-    double delta[4];
-    delta[0] = 0.0;
-    delta[1] = DATA.delta_x;
-    delta[2] = DATA.delta_y;
-    delta[3] = DATA.delta_eta*tau;
+    if (DATA.turn_on_shear == 1) {
+        auto Wmunu_local = Util::UnpackVecToMatrix(grid_pt.Wmunu);
+        for (int idx_1d = 4; idx_1d < 9; idx_1d++) {
+            int mu = 0;
+            int nu = 0;
+            Util::map_1d_idx_to_2d(idx_1d, mu, nu);
+
+            /* add a source term -u^tau Wmn/tau
+               due to the coordinate change to tau-eta */
+            /* this is from udW = d(uW) - Wdu = RHS */
+            /* or d(uW) = udW + Wdu */
+            /* this term is being added to the rhs so that -4/3 + 1 = -1/3 */
+            /* other source terms due to the coordinate change to tau-eta */
+            double tempf = (
+                 - (DATAaligned->gmunu[3][mu])*(Wmunu_local[0][nu])
+                 - (DATAaligned->gmunu[3][nu])*(Wmunu_local[0][mu])
+                 + (DATAaligned->gmunu[0][mu])*(Wmunu_local[3][nu])
+                 + (DATAaligned->gmunu[0][nu])*(Wmunu_local[3][mu])
+                 + (Wmunu_local[3][nu])
+                 *(grid_pt.u[mu])*(grid_pt.u[0])
+                 + (Wmunu_local[3][mu])
+                 *(grid_pt.u[nu])*(grid_pt.u[0])
+                 - (Wmunu_local[0][nu])
+                 *(grid_pt.u[mu])*(grid_pt.u[3])
+                 - (Wmunu_local[0][mu])
+                 *(grid_pt.u[nu])*(grid_pt.u[3]))*(grid_pt.u[3]/tau);
+
+            for (int ic = 0; ic < 4; ic++) {
+                const double ic_fac = (ic == 0 ? -1.0 : 1.0);
+                tempf += (
+                    (Wmunu_local[ic][nu])*(grid_pt.u[mu])
+                    *(a_local[ic])*ic_fac
+                    + (Wmunu_local[ic][mu])*(grid_pt.u[nu])
+                    *(a_local[ic])*ic_fac);
+            }
 
-    double sum = 0.0;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        /* Get_uPis */
-        double g = c.pi_b;
-        double f = g*c.u[direction];
-        g *= c.u[0];
-
-        double gp2 = p2.pi_b;
-        double fp2 = gp2*p2.u[direction];
-        gp2 *= p2.u[0];
-
-        double gp1 = p1.pi_b;
-        double fp1 = gp1*p1.u[direction];
-        gp1 *= p1.u[0];
-
-        double gm1 = m1.pi_b;
-        double fm1 = gm1*m1.u[direction];
-        gm1 *= m1.u[0];
-
-        double gm2 = m2.pi_b;
-        double fm2 = gm2*m2.u[direction];
-        gm2 *= m2.u[0];
-
-        /*  Make upi Halfs */
-        /* uPi */
-        double uPiphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uPiphL = f + temp;
-        double uPimhR = f - temp;
-        double uPimhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Pi */
-        double PiphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double PiphL = g + temp;
-        double PimhR = g - temp;
-        double PimhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-        /* MakePimnCurrents following Kurganov-Tadmor */
-        double a = fabs(c.u[direction]);
-        a /= c.u[0];
-
-        double am1 = fabs(m1.u[direction]);
-        am1 /= m1.u[0];
-
-        double ap1 = fabs(p1.u[direction]);
-        ap1 /= p1.u[0];
-
-        double ax = std::max(a, ap1);
-        double HPiph = ((uPiphR + uPiphL) - ax*(PiphR - PiphL))*0.5;
-
-        ax = std::max(a, am1);
-        double HPimh = ((uPimhR + uPimhL) - ax*(PimhR - PimhL))*0.5;
-
-        double HPi = (HPiph - HPimh)/delta[direction];
-
-        /* make partial_i (u^i Pi) */
-        sum += -HPi;
-    });
+            w_rhs[idx_1d] += (
+                tempf*(DATAaligned->delta_tau)
+                + (- (grid_pt.u[0]*Wmunu_local[mu][nu])/tau
+                   + (theta_local*Wmunu_local[mu][nu]))
+                  *(DATAaligned->delta_tau));
+        }
+    }
 
-     /* add a source term due to the coordinate change to tau-eta */
-     sum -= (grid_pt->pi_b)*(grid_pt->u[0])/tau;
-     sum += (grid_pt->pi_b)*theta_local;
-     *p_rhs = sum*(DATA.delta_tau);
+    if (flag_bulk) {
+        /* add a source term due to the coordinate change to tau-eta */
+        pi_sum -= (grid_pt.pi_b)*(grid_pt.u[0])/tau;
+        pi_sum += (grid_pt.pi_b)*theta_local;
+        p_rhs = pi_sum*(DATA.delta_tau);
+    }
 
-     return 1;
+    if (DATA.turn_on_diff == 1) {
+        /* the source terms -u^tau q^mu/tau and theta q^mu due to the
+         * coordinate change to tau-eta are included in Make_uqSource */
+        for (int nu = 1; nu < 4; nu++) {
+            w_rhs[10 + nu] = q_sum[nu]*(DATA.delta_tau);
+        }
+    }
 }
 
 
-double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, 
-                        int rk_flag, double theta_local, VelocityShearVec &sigma_1d) {
+//! bulk part of Make_uWSource
+double Diss::Make_uPiSource(const Cell_small *grid_pt, const double epsilon,
+                            const double rhob, const double pressure,
+                            const double temperature,
+                            const double theta_local,
+                            const VelocityShearVec &sigma_1d) {
     double tempf;
     double bulk;
     double Bulk_Relax_time;
@@ -627,26 +654,15 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
         include_coupling_to_shear = 1;
     }
 
-    double epsilon, rhob;
-    if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
-    } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
-    }
-
     // defining bulk viscosity coefficient
 
     // shear viscosity = constant * entropy density
     //s_den = eos.get_entropy(epsilon, rhob);
     //shear = (DATA.shear_to_s)*s_den;   
     // shear viscosity = constant * (e + P)/T
-    double temperature = eos.get_temperature(epsilon, rhob);
 
     // cs2 is the velocity of sound squared
     double cs2 = eos.get_cs2(epsilon, rhob);
-    double pressure = eos.get_pressure(epsilon, rhob);
 
     // T dependent bulk viscosity from Gabriel
     bulk = transport_coeffs_.get_zeta_over_s(temperature);
@@ -743,21 +759,13 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
     -Delta[a][eta] u[eta] q[tau]/tau
     -u[a]u[b]g[b][e] Dq[e]
 */
-double Diss::Make_uqSource(
-    double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, int nu,
-    int rk_flag, double theta_local, DumuVec &a_local,
-    VelocityShearVec &sigma_1d, DmuMuBoverTVec &baryon_diffusion_vec) {
-
-    double epsilon, rhob;
-    if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
-    } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
-    }
-    double pressure = eos.get_pressure(epsilon, rhob);
-    double T        = eos.get_temperature(epsilon, rhob);
+//! diffusion part of Make_uWSource, for the components w_source[11-13]
+void Diss::Make_uqSource(
+    const double tau, const Cell_small *grid_pt, const double epsilon,
+    const double rhob, const double pressure, const double T,
+    const double theta_local, const DumuVec &a_local,
+    const VelocityShearVec &sigma_1d,
+    const DmuMuBoverTVec &baryon_diffusion_vec, ViscousVec &w_source) {
 
     double kappa_coefficient = DATA.kappa_coefficient;
     double tau_rho = kappa_coefficient/(T + 1e-15);
@@ -786,155 +794,69 @@ double Diss::Make_uqSource(
      * - u[a] u[b]g[b][e] Dq[e] -> u[a] q[e] g[e][b] Du[b]
     */
 
-    // first: (1/tau_rho) part
-    // recall that dUsup[4][i] = partial_i (muB/T)
-    // and dUsup[4][0] = -partial_tau (muB/T) = partial^tau (muB/T)
-    // and a[4] = u^a partial_a (muB/T) = DmuB/T
-    // -(1/tau_rho)(q[a] + kappa g[a][b]DmuB/T[b]
-    // + kappa u[a] u[b]g[b][c]DmuB/T[c])
-    // a = nu
-    double NS = kappa*(baryon_diffusion_vec[nu] + grid_pt->u[nu]*a_local[4]);
-
-    // add a new non-linear term (- q \theta)
     double transport_coeff = transport_coeffs_.get_delta_qq_coeff()*tau_rho;
-    double Nonlinear1 = -transport_coeff*q[nu]*theta_local;
-
-    // add a new non-linear term (-q^\mu \sigma_\mu\nu)
     double transport_coeff_2 = transport_coeffs_.get_lambda_qq_coeff()*tau_rho;
     auto sigma = Util::UnpackVecToMatrix(sigma_1d);
-    double temptemp = 0.0;
-    for (int i = 0 ; i < 4; i++) {
-        temptemp += q[i]*sigma[i][nu]*DATA.gmunu[i][i];
-    }
-    double Nonlinear2 = - transport_coeff_2*temptemp;
 
-    double SW = (-q[nu] - NS + Nonlinear1 + Nonlinear2)/(tau_rho + 1e-15);
-    if (DATA.Initial_profile == 1) {
-        // for 1+1D numerical test
-        SW = (-q[nu] - NS)/(tau_rho + 1e-15);
-    }
+    for (int nu = 1; nu < 4; nu++) {
+        // first: (1/tau_rho) part
+        // recall that dUsup[4][i] = partial_i (muB/T)
+        // and dUsup[4][0] = -partial_tau (muB/T) = partial^tau (muB/T)
+        // and a[4] = u^a partial_a (muB/T) = DmuB/T
+        // -(1/tau_rho)(q[a] + kappa g[a][b]DmuB/T[b]
+        // + kappa u[a] u[b]g[b][c]DmuB/T[c])
+        // a = nu
+        double NS = kappa*(baryon_diffusion_vec[nu] + grid_pt->u[nu]*a_local[4]);
+
+        // add a new non-linear term (- q \theta)
+        double Nonlinear1 = -transport_coeff*q[nu]*theta_local;
+
+        // add a new non-linear term (-q^\mu \sigma_\mu\nu)
+        double temptemp = 0.0;
+        for (int i = 0 ; i < 4; i++) {
+            temptemp += q[i]*sigma[i][nu]*DATA.gmunu[i][i];
+        }
+        double Nonlinear2 = - transport_coeff_2*temptemp;
 
-    // all other geometric terms....
-    // + theta q[a] - q[a] u^\tau/tau
-    SW += (theta_local - grid_pt->u[0]/tau)*q[nu];
-    // if (isnan(SW)) {
-    //     cout << "theta term is nan! " << endl;
-    // }
-
-    // +Delta[a][tau] u[eta] q[eta]/tau
-    double tempf = ((DATA.gmunu[nu][0]
-                    + grid_pt->u[nu]*grid_pt->u[0])
-                      *grid_pt->u[3]*q[3]/tau
-                    - (DATA.gmunu[nu][3]
-                       + grid_pt->u[nu]*grid_pt->u[3])
-                      *grid_pt->u[3]*q[0]/tau);
-    SW += tempf;
-    // if (isnan(tempf)) {
-    //     cout << "Delta^{a \tau} and Delta^{a \eta} terms are nan!" << endl;
-    // }
-
-    // -u[a] u[b]g[b][e] Dq[e] -> u[a] (q[e] g[e][b] Du[b])
-    tempf = 0.0;
-    for (int i = 0; i < 4; i++) {
-        tempf += q[i]*Util::gmn(i)*a_local[i];
+        double SW = (-q[nu] - NS + Nonlinear1 + Nonlinear2)/(tau_rho + 1e-15);
+        if (DATA.Initial_profile == 1) {
+            // for 1+1D numerical test
+            SW = (-q[nu] - NS)/(tau_rho + 1e-15);
+        }
+
+        // all other geometric terms....
+        // + theta q[a] - q[a] u^\tau/tau
+        SW += (theta_local - grid_pt->u[0]/tau)*q[nu];
+        // if (isnan(SW)) {
+        //     cout << "theta term is nan! " << endl;
+        // }
+
+        // +Delta[a][tau] u[eta] q[eta]/tau
+        double tempf = ((DATA.gmunu[nu][0]
+                        + grid_pt->u[nu]*grid_pt->u[0])
+                          *grid_pt->u[3]*q[3]/tau
+                        - (DATA.gmunu[nu][3]
+                           + grid_pt->u[nu]*grid_pt->u[3])
+                          *grid_pt->u[3]*q[0]/tau);
+        SW += tempf;
+        // if (isnan(tempf)) {
+        //     cout << "Delta^{a \tau} and Delta^{a \eta} terms are nan!" << endl;
+        // }
+
+        // -u[a] u[b]g[b][e] Dq[e] -> u[a] (q[e] g[e][b] Du[b])
+        tempf = 0.0;
+        for (int i = 0; i < 4; i++) {
+            tempf += q[i]*Util::gmn(i)*a_local[i];
+        }
+        SW += (grid_pt->u[nu])*tempf;
+        // if (isnan(tempf)) {
+        //     cout << "u^a q_b Du^b term is nan! " << endl;
+        // }
+        w_source[10 + nu] = SW;
     }
-    SW += (grid_pt->u[nu])*tempf;
-    // if (isnan(tempf)) {
-    //     cout << "u^a q_b Du^b term is nan! " << endl;
-    // }
-    return SW;
 }
 
 
-double Diss::Make_uqRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
-                        int mu, int nu) {
-    /* Kurganov-Tadmor for q */
-    /* implement 
-      partial_tau (utau qmu) + (1/tau)partial_eta (ueta qmu) 
-      + partial_x (ux qmu) + partial_y (uy qmu) + utau qmu/tau = SW 
-    or the right hand side of,
-      partial_tau (utau qmu) = 
-      - (1/tau)partial_eta (ueta qmu) - partial_x (ux qmu) - partial_y (uy qmu) 
-      - utau qmu/tau 
-    */
-
-    /* the local velocity is just u_x/u_tau, u_y/u_tau, u_eta/tau/u_tau */
-    /* KT flux is given by 
-       H_{j+1/2} = (fRph + fLph)/2 - ax(uRph - uLph) 
-       Here fRph = ux WmnRph and ax uRph = |ux/utau|_max utau Wmn */
-
-    /* This is the second step in the operator splitting. it uses
-       rk_flag+1 as initial condition */
-
-    double delta[4] = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta*tau};
-
-    // we use the Wmunu[4][nu] = q[nu]
-    int idx_1d = map_2d_idx_to_1d(mu, nu);
-    double sum = 0.0;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        /* Get_uWmns */
-        double g = c.Wmunu[idx_1d];
-        double f = g*c.u[direction];
-        g *=   c.u[0];
-
-        double gp2 = p2.Wmunu[idx_1d];
-        double fp2 = gp2*p2.u[direction];
-        gp2 *=     p2.u[0];
-
-        double gp1 = p1.Wmunu[idx_1d];
-        double fp1 = gp1*p1.u[direction];
-        gp1 *=     p1.u[0];
-
-        double gm1 = m1.Wmunu[idx_1d];
-        double fm1 = gm1*m1.u[direction];
-        gm1 *=     m1.u[0];
-
-        double gm2 = m2.Wmunu[idx_1d];
-        double fm2 = gm2*m2.u[direction];
-        gm2 *=     m2.u[0];
-
-        /*  MakeuWmnHalfs */
-        /* uWmn */
-        double uWphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uWphL = f + temp;
-        double uWmhR = f - temp;
-        double uWmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Wmn */
-        double WphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double WphL = g + temp;
-        double WmhR = g - temp;
-        double WmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-        double a = fabs(c.u[direction])/c.u[0];
-
-        double am1 = (fabs(m1.u[direction])/m1.u[0]);
-        double ap1 = (fabs(p1.u[direction])/p1.u[0]);
-        double ax = std::max(a, ap1);
-        double HWph = ((uWphR + uWphL) - ax*(WphR - WphL))*0.5;
-
-        ax = std::max(a, am1);
-        double HWmh = ((uWmhR + uWmhL) - ax*(WmhR - WmhL))*0.5;
-
-        double HW = (HWph - HWmh)/delta[direction];
-        /* make partial_i (u^i Wmn) */
-        sum += -HW;
-    });
-
-    /* add a source term -u^tau Wmn/tau due to the coordinate 
-     * change to tau-eta */
-    /* Sangyong Nov 18 2014: don't need this. included in the uqSource. */
-    /* this is from udW = d(uW) - Wdu = RHS */
-    /* or d(uW) = udW + Wdu */
-    /* 
-     * sum -= (grid_pt->u[rk_flag][0])*(grid_pt->Wmunu[rk_flag][mu][nu])/tau;
-     * sum += (grid_pt->theta_u[rk_flag])*(grid_pt->Wmunu[rk_flag][mu][nu]);
-    */  
-    return(sum*(DATA.delta_tau));
-}
-
 //! this function outputs the T and muB dependence of the baryon diffusion
 //! coefficient, kappa
 void Diss::output_kappa_T_and_muB_dependence() {
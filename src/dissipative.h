@@ -30,30 +30,35 @@ class Diss {
 
  public:
     Diss(const EOS &eosIn, const InitData &DATA_in);
-    void MakeWSource(const double tau,
+    void MakeWSource(const double tau, const double delta_tau_prev,
                      SCGrid &arena_current, SCGrid &arena_prev,
                      const int ix, const int iy, const int ieta,
                      TJbVec &dwmn);
 
-    double Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
-                         int mu, int nu, int rk_flag, double theta_local,
-                         DumuVec &a_local, VelocityShearVec &sigma_1d);
+    void Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+                    double theta_local, const DumuVec &a_local,
+                    ViscousVec &w_rhs, double &p_rhs);
 
-    int Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
-                   int mu, int nu, double &w_rhs,
-                   double theta_local, DumuVec &a_local);
+    void Make_uWSource(double tau, const Cell_small *grid_pt,
+                       double theta_local, const DumuVec &a_local,
+                       const VelocityShearVec &sigma_1d,
+                       const DmuMuBoverTVec &baryon_diffusion_vec,
+                       ViscousVec &w_source, double &pi_source);
 
-    int Make_uPRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
-                   double *p_rhs, double theta_local);
-    double Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
-                          int rk_flag, double theta_local, VelocityShearVec &sigma_1d);
-
-    double Make_uqRHS(double tau, SCGrid &arena_current, int ix, int iy, int ieta,
-                      int mu, int nu);
-    double Make_uqSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, int nu,
-                         int rk_flag, double theta_local, DumuVec &a_local,
-                         VelocityShearVec &sigma_1d,
-                         DmuMuBoverTVec &baryon_diffusion_vec);
+    void Make_uWSource_shear(const Cell_small *grid_pt, double epsilon,
+                             double pressure, double T, double theta_local,
+                             const VelocityShearVec &sigma_1d,
+                             ViscousVec &w_source);
+    double Make_uPiSource(const Cell_small *grid_pt, double epsilon,
+                          double rhob, double pressure, double temperature,
+                          double theta_local,
+                          const VelocityShearVec &sigma_1d);
+    void Make_uqSource(double tau, const Cell_small *grid_pt, double epsilon,
+                       double rhob, double pressure, double T,
+                       double theta_local, const DumuVec &a_local,
+                       const VelocityShearVec &sigma_1d,
+                       const DmuMuBoverTVec &baryon_diffusion_vec,
+                       ViscousVec &w_source);
 
     double get_temperature_dependent_eta_s(double T);
     double get_temperature_dependent_zeta_s(double temperature);
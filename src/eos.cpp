@@ -11,9 +11,41 @@
 #include <iostream>
 #include <memory>
 
-EOS::EOS(const int eos_id_in) : eos_id(eos_id_in)  {
+namespace {
+
+template <class EOS_t>
+void pressure_loop(const EOS_t &eos_impl, const double *e, const double *rhob,
+                   double *pressure, const int n) {
+    for (int i = 0; i < n; i++) {
+        pressure[i] = eos_impl.get_pressure(e[i], rhob[i]);
+    }
+}
+
+template <class EOS_t>
+void cs2_loop(const EOS_t &eos_impl, const double *e, const double *rhob,
+              double *cs2, const int n) {
+    for (int i = 0; i < n; i++) {
+        cs2[i] = eos_impl.get_cs2(e[i], rhob[i]);
+    }
+}
+
+template <class EOS_t>
+void temperature_loop(const EOS_t &eos_impl, const double *e,
+                      const double *rhob, double *temperature, const int n) {
+    for (int i = 0; i < n; i++) {
+        temperature[i] = eos_impl.get_temperature(e[i], rhob[i]);
+    }
+}
+
+}  // namespace
+
+EOS::EOS(const int eos_id_in, const int interpolation_order,
+         const double resample_tolerance, const bool derivative_tables)
+    : eos_id(eos_id_in)  {
+    eos_type = EOSType::generic;
     if (eos_id == 0) {
         eos_ptr = std::unique_ptr<EOS_idealgas> (new EOS_idealgas ());
+        eos_type = EOSType::ideal_gas;
     } else if (eos_id == 1) {
         eos_ptr = std::unique_ptr<EOS_eosQ> (new EOS_eosQ ());
     } else if (eos_id >= 2 && eos_id <= 7) {
@@ -22,8 +54,10 @@ EOS::EOS(const int eos_id_in) : eos_id(eos_id_in)  {
         eos_ptr = std::unique_ptr<EOS_WB> (new EOS_WB ());
     } else if (eos_id == 9) {
         eos_ptr = std::unique_ptr<EOS_hotQCD> (new EOS_hotQCD ());
+        eos_type = EOSType::single_table;
     } else if (eos_id >= 10 && eos_id <= 14) {
         eos_ptr = std::unique_ptr<EOS_neos> (new EOS_neos (eos_id));
+        eos_type = EOSType::multi_table;
     } else if (eos_id == 17) {
         eos_ptr = std::unique_ptr<EOS_BEST> (new EOS_BEST ());
     } else {
@@ -31,5 +65,71 @@ EOS::EOS(const int eos_id_in) : eos_id(eos_id_in)  {
         exit(1);
     }
     eos_ptr->initialize_eos();
+    if (resample_tolerance > 0.) {
+        eos_ptr->resample_1D_tables(resample_tolerance);
+    } else if (interpolation_order != 1) {
+        eos_ptr->set_interpolation_order(interpolation_order);
+    }
+    eos_ptr->build_table_idx_lookup();
+    if (derivative_tables) {
+        eos_ptr->build_derivative_tables();
+    }
 }
 
+
+
+void EOS::get_pressure(const double *e, const double *rhob,
+                       double *pressure, const int n) const {
+    switch (eos_type) {
+        case EOSType::ideal_gas:
+            pressure_loop(get_eos_impl<EOS_idealgas>(), e, rhob, pressure, n);
+            break;
+        case EOSType::single_table:
+            pressure_loop(get_eos_impl<EOS_hotQCD>(), e, rhob, pressure, n);
+            break;
+        case EOSType::multi_table:
+            pressure_loop(get_eos_impl<EOS_neos>(), e, rhob, pressure, n);
+            break;
+        default:
+            pressure_loop(*eos_ptr, e, rhob, pressure, n);
+    }
+}
+
+
+void EOS::get_cs2(const double *e, const double *rhob,
+                  double *cs2, const int n) const {
+    switch (eos_type) {
+        case EOSType::ideal_gas:
+            cs2_loop(get_eos_impl<EOS_idealgas>(), e, rhob, cs2, n);
+            break;
+        case EOSType::single_table:
+            cs2_loop(get_eos_impl<EOS_hotQCD>(), e, rhob, cs2, n);
+            break;
+        case EOSType::multi_table:
+            cs2_loop(get_eos_impl<EOS_neos>(), e, rhob, cs2, n);
+            break;
+        default:
+            cs2_loop(*eos_ptr, e, rhob, cs2, n);
+    }
+}
+
+
+void EOS::get_temperature(const double *e, const double *rhob,
+                          double *temperature, const int n) const {
+    switch (eos_type) {
+        case EOSType::ideal_gas:
+            temperature_loop(get_eos_impl<EOS_idealgas>(), e, rhob,
+                             temperature, n);
+            break;
+        case EOSType::single_table:
+            temperature_loop(get_eos_impl<EOS_hotQCD>(), e, rhob,
+                             temperature, n);
+            break;
+        case EOSType::multi_table:
+            temperature_loop(get_eos_impl<EOS_neos>(), e, rhob,
+                             temperature, n);
+            break;
+        default:
+            temperature_loop(*eos_ptr, e, rhob, temperature, n);
+    }
+}
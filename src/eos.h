@@ -4,28 +4,115 @@
 #define SRC_EOS_H_
 
 #include "eos_base.h"
+#include "eos_idealgas.h"
+#include "eos_hotQCD.h"
+#include "eos_neos.h"
 #include <memory>
+#include <string>
+
+//! The EOS families that the hydro kernels are specialized for.
+//! The family is fixed at construction; all other EOS go through the
+//! virtual interface of EOS_base
+enum class EOSType {ideal_gas, single_table, multi_table, generic};
 
 //! This is a wrapper class for the equation of state
 class EOS {
  private:
     const int eos_id;
+    EOSType eos_type;
 
     std::unique_ptr<EOS_base> eos_ptr;
 
  public:
     EOS() = default;
-    EOS(const int eos_id_in);
+    EOS(const int eos_id_in, const int interpolation_order = 1,
+        const double resample_tolerance = 0.,
+        const bool derivative_tables = false);
 
     ~EOS() {};
 
+    EOSType get_eos_type() const {return(eos_type);}
+
+    //! returns the EOS as its concrete class. The classes are final, so
+    //! calls through the returned reference are resolved at compile time.
+    //! EOS_t must match get_eos_type() (or be EOS_base)
+    template <class EOS_t>
+    const EOS_t& get_eos_impl() const {
+        return(static_cast<const EOS_t&>(*eos_ptr));
+    }
+
+    // the hot functions switch on the EOS family instead of going
+    // through the vtable, so the ideal gas reduces to plain arithmetic
+    double get_pressure(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::ideal_gas:
+                return(get_eos_impl<EOS_idealgas>().get_pressure(e, rhob));
+            case EOSType::single_table:
+                return(get_eos_impl<EOS_hotQCD>().get_pressure(e, rhob));
+            case EOSType::multi_table:
+                return(get_eos_impl<EOS_neos>().get_pressure(e, rhob));
+            default:
+                return(eos_ptr->get_pressure(e, rhob));
+        }
+    }
+    double get_cs2(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::ideal_gas:
+                return(get_eos_impl<EOS_idealgas>().get_cs2(e, rhob));
+            case EOSType::single_table:
+                return(get_eos_impl<EOS_hotQCD>().get_cs2(e, rhob));
+            case EOSType::multi_table:
+                return(get_eos_impl<EOS_neos>().get_cs2(e, rhob));
+            default:
+                return(eos_ptr->get_cs2(e, rhob));
+        }
+    }
+    double get_dpde(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::ideal_gas:
+                return(get_eos_impl<EOS_idealgas>().p_e_func(e, rhob));
+            case EOSType::single_table:
+                return(get_eos_impl<EOS_hotQCD>().p_e_func(e, rhob));
+            case EOSType::multi_table:
+                return(get_eos_impl<EOS_neos>().p_e_func(e, rhob));
+            default:
+                return(eos_ptr->p_e_func(e, rhob));
+        }
+    }
+    double get_dpdrhob(double e, double rhob) const {
+        switch (eos_type) {
+            case EOSType::ideal_gas:
+                return(get_eos_impl<EOS_idealgas>().p_rho_func(e, rhob));
+            case EOSType::single_table:
+                return(get_eos_impl<EOS_hotQCD>().p_rho_func(e, rhob));
+            case EOSType::multi_table:
+                return(get_eos_impl<EOS_neos>().p_rho_func(e, rhob));
+            default:
+                return(eos_ptr->p_rho_func(e, rhob));
+        }
+    }
+
+    // batched versions of the hot functions, the EOS family is resolved
+    // once for the whole array
+    void get_pressure   (const double *e, const double *rhob,
+                         double *pressure, const int n) const;
+    void get_cs2        (const double *e, const double *rhob,
+                         double *cs2, const int n) const;
+    void get_temperature(const double *e, const double *rhob,
+                         double *temperature, const int n) const;
+
     // functions to call the function pointers
-    double get_pressure   (double e, double rhob) const {return(eos_ptr->get_pressure(e, rhob));}
     double get_temperature(double e, double rhob) const {return(eos_ptr->get_temperature(e, rhob));}
     double get_entropy    (double e, double rhob) const {return(eos_ptr->get_entropy(e, rhob));}
-    double get_cs2        (double e, double rhob) const {return(eos_ptr->get_cs2(e, rhob));}
-    double get_dpde       (double e, double rhob) const {return(eos_ptr->p_e_func(e, rhob));}
-    double get_dpdrhob    (double e, double rhob) const {return(eos_ptr->p_rho_func(e, rhob));}
+
+    //! returns the pressure, the temperature and the entropy density at
+    //! (e, rhob) with one table lookup for each of them
+    void get_thermodynamics(double e, double rhob, double &pressure,
+                            double &temperature, double &entropy) const {
+        pressure    = get_pressure(e, rhob);
+        temperature = eos_ptr->get_temperature(e, rhob);
+        entropy     = eos_ptr->get_entropy(e, rhob, pressure, temperature);
+    }
     double get_muB        (double e, double rhob) const {return(eos_ptr->get_muB(e, rhob));}
     double get_muS        (double e, double rhob) const {return(eos_ptr->get_muS(e, rhob));}
     double get_muC        (double e, double rhob) const {return(eos_ptr->get_muC(e, rhob));}
@@ -33,6 +120,12 @@ class EOS {
     double get_T2e        (double T, double rhob) const {return(eos_ptr->get_T2e(T, rhob));}
 
     double get_eps_max() const {return(eos_ptr->get_eps_max());}
+    int get_interpolation_order() const {
+        return(eos_ptr->get_interpolation_order());
+    }
+    void output_tables(std::string filename_prefix) const {
+        eos_ptr->output_1D_tables(filename_prefix);
+    }
     void   check_eos()   const {return(eos_ptr->check_eos());}
 };
 
@@ -107,12 +107,12 @@ void EOS_eosQ::initialize_eos() {
 
 
 double EOS_eosQ::p_e_func(double e, double rhob) const {
-    return(get_dpOverde3(e, rhob));
+    return(interpolate_dpde(e, rhob));
 }
 
 
 double EOS_eosQ::p_rho_func(double e, double rhob) const {
-    return(get_dpOverdrhob2(e, rhob));
+    return(interpolate_dpdrhob(e, rhob));
 }
 
 
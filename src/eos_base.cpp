@@ -1,7 +1,10 @@
 
 #include "eos_base.h"
 #include "util.h"
+#include "doctest.h"
 
+#include <cmath>
+#include <limits>
 #include <string>
 #include <sstream>
 #include <iomanip>
@@ -28,90 +31,99 @@ EOS_base::~EOS_base() {
         delete[] pressure_tb;
         delete[] temperature_tb;
     }
+    if (pressure_slope_tb != nullptr) {
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            Util::mtx_free(pressure_slope_tb[itable],
+                           nb_length[itable], e_length[itable]);
+            Util::mtx_free(temperature_slope_tb[itable],
+                           nb_length[itable], e_length[itable]);
+        }
+        delete[] pressure_slope_tb;
+        delete[] temperature_slope_tb;
+    }
+    if (dpde_tb != nullptr) {
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            Util::mtx_free(dpde_tb[itable],
+                           nb_length[itable], e_length[itable]);
+            Util::mtx_free(dpdrhob_tb[itable],
+                           nb_length[itable], e_length[itable]);
+            Util::mtx_free(cs2_tb[itable],
+                           nb_length[itable], e_length[itable]);
+        }
+        delete[] dpde_tb;
+        delete[] dpdrhob_tb;
+        delete[] cs2_tb;
+    }
 }
 
 
-double EOS_base::interpolate1D(double e, int table_idx, double ***table) const {
-// This is a generic linear interpolation routine for EOS at zero mu_B
-// it assumes the class has already read in
-//        P(e), T(e), s(e)
-// as one-dimensional arrays on an equally spacing lattice grid
-// units: e is in 1/fm^4
-    //double local_ed = e*hbarc;  // [GeV/fm^3]
-    double local_ed = e;
-
-    const double e0       = e_bounds[table_idx];
-    const double delta_e  = e_spacing[table_idx];
-    const int N_e         = e_length[table_idx];
-
-    // compute the indices
-    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
-
-    // treatment for overflow, use the last two points to do extrapolation
-    idx_e  = std::min(N_e - 2, idx_e);
+namespace {
 
-    // check underflow
-    idx_e  = std::max(0, idx_e);
-
-    const double frac_e = (local_ed - (idx_e*delta_e + e0))/delta_e;
-
-    double result;
-    double temp1 = table[table_idx][0][idx_e];
-    double temp2 = table[table_idx][0][idx_e + 1];
-    result = temp1*(1. - frac_e) + temp2*frac_e;
-    return(result);
+//! Fritsch-Carlson node slopes for a monotone cubic interpolation
+//! of y on a uniform grid with spacing h
+void monotone_cubic_slopes(const double *y, const int n, const double h,
+                           double *m) {
+    std::vector<double> d(n - 1);
+    for (int k = 0; k < n - 1; k++) {
+        d[k] = (y[k+1] - y[k])/h;
+    }
+    m[0] = d[0];
+    m[n-1] = d[n-2];
+    for (int k = 1; k < n - 1; k++) {
+        m[k] = (d[k-1]*d[k] > 0. ? 0.5*(d[k-1] + d[k]) : 0.);
+    }
+    for (int k = 0; k < n - 1; k++) {
+        if (d[k] == 0.) {
+            m[k] = 0.;
+            m[k+1] = 0.;
+            continue;
+        }
+        const double a = m[k]/d[k];
+        const double b = m[k+1]/d[k];
+        const double r = a*a + b*b;
+        if (r > 9.) {
+            const double tau = 3./sqrt(r);
+            m[k] = tau*a*d[k];
+            m[k+1] = tau*b*d[k];
+        }
+    }
 }
 
 
-double EOS_base::interpolate2D(double e, double rhob, int table_idx, double ***table) const {
-// This is a generic bilinear interpolation routine for EOS at finite mu_B
-// it assumes the class has already read in
-//        P(e, rho_b), T(e, rho_b), s(e, rho_b), mu_b(e, rho_b)
-// as two-dimensional arrays on an equally spacing lattice grid
-// units: e is in 1/fm^4, rhob is in 1/fm^3
-    //double local_ed = e*hbarc;  // [GeV/fm^3]
-    double local_ed = e;
-    double local_nb = rhob;     // [1/fm^3]
-
-    double e0       = e_bounds[table_idx];
-    double nb0      = nb_bounds[table_idx];
-    double delta_e  = e_spacing[table_idx];
-    double delta_nb = nb_spacing[table_idx];
-
-    int N_e  = e_length[table_idx];
-    int N_nb = nb_length[table_idx];
-
-    // compute the indices
-    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
-    int idx_nb = static_cast<int>((local_nb - nb0)/delta_nb);
-
-    // treatment for overflow, use the last two points to do extrapolation
-    idx_e  = std::min(N_e - 2, idx_e);
-    idx_nb = std::min(N_nb - 2, idx_nb);
-
-    // check underflow
-    idx_e  = std::max(0, idx_e);
-    idx_nb = std::max(0, idx_nb);
-
-    double frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
-    double frac_rhob = (local_nb - (idx_nb*delta_nb + nb0))/delta_nb;
-
-    double result;
-    double temp1 = table[table_idx][idx_nb][idx_e];
-    double temp2 = table[table_idx][idx_nb][idx_e + 1];
-    double temp3 = table[table_idx][idx_nb + 1][idx_e + 1];
-    double temp4 = table[table_idx][idx_nb + 1][idx_e];
-    result = ((temp1*(1. - frac_e) + temp2*frac_e)*(1. - frac_rhob)
-              + (temp3*frac_e + temp4*(1. - frac_e))*frac_rhob);
-    return(result);
+//! evaluates the cubic Hermite interpolation of (y, m) at x,
+//! same as EOS_base::interpolate1D_cubic
+double hermite_cubic(const std::vector<double> &y,
+                     const std::vector<double> &m,
+                     const double x0, const double h, const double x) {
+    const int n = y.size();
+    int idx = static_cast<int>((x - x0)/h);
+    idx = std::max(0, std::min(n - 2, idx));
+    const double t = (x - (idx*h + x0))/h;
+    if (t < 0.) return(y[idx] + m[idx]*h*t);
+    if (t > 1.) return(y[idx+1] + m[idx+1]*h*(t - 1.));
+    const double t2 = t*t;
+    const double t3 = t2*t;
+    return(  (2.*t3 - 3.*t2 + 1.)*y[idx] + (t3 - 2.*t2 + t)*m[idx]*h
+           + (-2.*t3 + 3.*t2)*y[idx+1] + (t3 - t2)*m[idx+1]*h);
 }
 
+}  // namespace
+
 
 //! This function returns entropy density in [1/fm^3]
 //! The input local energy density e [1/fm^4], rhob[1/fm^3]
 double EOS_base::get_entropy(double epsilon, double rhob) const {
-    auto P    = get_pressure(epsilon, rhob);
-    auto T    = get_temperature(epsilon, rhob);
+    return(get_entropy(epsilon, rhob, get_pressure(epsilon, rhob),
+                       get_temperature(epsilon, rhob)));
+}
+
+
+double EOS_base::get_entropy(double epsilon, double rhob,
+                             double P, double T) const {
+    if (rhob == 0.) {
+        // the charge densities all vanish with rhob
+        return(std::max(1e-15, (epsilon + P)/(T + 1e-15)));
+    }
     auto muB  = get_muB(epsilon, rhob);
     auto muS  = get_muS(epsilon, rhob);
     auto muC  = get_muC(epsilon, rhob);
@@ -123,7 +135,7 @@ double EOS_base::get_entropy(double epsilon, double rhob) const {
 
 
 double EOS_base::get_cs2(double e, double rhob) const {
-    double f = calculate_velocity_of_sound_sq(e, rhob);
+    double f = interpolate_cs2(e, rhob);
     return(f);
 }
 
@@ -168,18 +180,6 @@ double EOS_base::get_dpOverdrhob2(double e, double rhob) const {
 }
 
 
-int EOS_base::get_table_idx(double e) const {
-    //double local_ed = e*hbarc;  // [GeV/fm^3]
-    double local_ed = e;  // [GeV/fm^3]
-    for (int itable = 1; itable < number_of_tables; itable++) {
-        if (local_ed < e_bounds[itable]) {
-            return(itable - 1);
-        }
-    }
-    return(std::max(0, number_of_tables - 1));
-}
-
-
 //! This function returns local energy density [1/fm^4] from
 //! a given temperature T [GeV] and rhob [1/fm^3] using binary search
 double EOS_base::get_T2e_finite_rhob(const double T, const double rhob) const {
@@ -295,6 +295,405 @@ void EOS_base::resize_table_info_arrays() {
 }
 
 
+//! This function tabulates dP/de, dP/drhob and cs^2 on the nodes of the
+//! pressure tables, so that the derivatives cost one table lookup.
+//! The derivatives are centered differences between neighbouring nodes
+//! (one-sided at the table edges), or the node slopes of the cubic
+//! interpolation. P is even in rhob, so dP/drhob = 0 at rhob = 0.
+//! The tables are only built with EOS_derivative_tables = 1, otherwise
+//! the derivatives are the finite differences of get_dpOverde3 and
+//! get_dpOverdrhob2.
+void EOS_base::build_derivative_tables() {
+    if (number_of_tables < 1 || dpde_tb != nullptr) return;
+
+    const double v_min = 0.01;
+    const double v_max = 1./3.;
+    dpde_tb    = new double** [number_of_tables];
+    dpdrhob_tb = new double** [number_of_tables];
+    cs2_tb     = new double** [number_of_tables];
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        const int N_e  = e_length[itable];
+        const int N_nb = nb_length[itable];
+        const double delta_e  = e_spacing[itable];
+        const double delta_nb = nb_spacing[itable];
+        double **P = pressure_tb[itable];
+        dpde_tb[itable]    = Util::mtx_malloc(N_nb, N_e);
+        dpdrhob_tb[itable] = Util::mtx_malloc(N_nb, N_e);
+        cs2_tb[itable]     = Util::mtx_malloc(N_nb, N_e);
+        for (int i = 0; i < N_nb; i++) {
+            for (int j = 0; j < N_e; j++) {
+                double dpde;
+                if (interpolation_order == 3) {
+                    dpde = pressure_slope_tb[itable][i][j];
+                } else if (N_e < 2) {
+                    dpde = 0.;
+                } else if (j == 0) {
+                    dpde = (P[i][1] - P[i][0])/delta_e;
+                } else if (j == N_e - 1) {
+                    dpde = (P[i][j] - P[i][j-1])/delta_e;
+                } else {
+                    dpde = (P[i][j+1] - P[i][j-1])/(2.*delta_e);
+                }
+
+                double dpdrho = 0.;
+                if (N_nb > 1) {
+                    if (i == 0) {
+                        if (nb_bounds[itable] > 0.) {
+                            dpdrho = (P[1][j] - P[0][j])/delta_nb;
+                        }
+                    } else if (i == N_nb - 1) {
+                        dpdrho = (P[i][j] - P[i-1][j])/delta_nb;
+                    } else {
+                        dpdrho = (P[i+1][j] - P[i-1][j])/(2.*delta_nb);
+                    }
+                }
+
+                const double e_local = e_bounds[itable] + j*delta_e;
+                const double rhob_local = nb_bounds[itable] + i*delta_nb;
+                double cs2 = (dpde + rhob_local/(e_local + P[i][j] + 1e-15)
+                                     *dpdrho);
+                dpde_tb[itable][i][j]    = dpde;
+                dpdrhob_tb[itable][i][j] = dpdrho;
+                cs2_tb[itable][i][j] = std::max(v_min, std::min(v_max, cs2));
+            }
+        }
+    }
+}
+
+
+//! dP/de [dimensionless] from the derivative tables, the finite
+//! difference is used if the tables are not built
+double EOS_base::interpolate_dpde(double e, double rhob) const {
+    if (dpde_tb == nullptr) return(get_dpOverde3(e, rhob));
+    const int table_idx = get_table_idx(e);
+    if (nb_length[table_idx] == 1) {
+        return(interpolate1D(e, table_idx, dpde_tb));
+    }
+    return(interpolate2D(e, std::abs(rhob), table_idx, dpde_tb));
+}
+
+
+//! dP/drhob [1/fm] from the derivative tables
+double EOS_base::interpolate_dpdrhob(double e, double rhob) const {
+    if (dpdrhob_tb == nullptr) return(get_dpOverdrhob2(e, rhob));
+    const int table_idx = get_table_idx(e);
+    if (nb_length[table_idx] == 1) return(0.0);
+    const double sign = rhob/(std::abs(rhob) + 1e-15);
+    return(sign*interpolate2D(e, std::abs(rhob), table_idx, dpdrhob_tb));
+}
+
+
+//! speed of sound squared from the derivative tables
+double EOS_base::interpolate_cs2(double e, double rhob) const {
+    if (cs2_tb == nullptr) return(calculate_velocity_of_sound_sq(e, rhob));
+    const int table_idx = get_table_idx(e);
+    if (nb_length[table_idx] == 1) {
+        return(interpolate1D(e, table_idx, cs2_tb));
+    }
+    return(interpolate2D(e, std::abs(rhob), table_idx, cs2_tb));
+}
+
+
+//! returns true if all tables only depend on e (zero mu_B)
+bool EOS_base::has_1D_tables() const {
+    if (number_of_tables < 1) return(false);
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        if (nb_length[itable] != 1) return(false);
+    }
+    return(true);
+}
+
+
+//! This function sets the interpolation order of the EoS tables.
+//! For order 3 the node derivatives of P(e) and T(e) are computed here.
+void EOS_base::set_interpolation_order(int order) {
+    if (order == 3 && !has_1D_tables()) {
+        if (number_of_tables > 0) {
+            music_message.warning(
+                "Cubic interpolation is only available for EoS tables at "
+                "zero mu_B. Use linear interpolation instead.");
+        }
+        interpolation_order = 1;
+        return;
+    }
+    interpolation_order = order;
+    if (order != 3) return;
+
+    if (pressure_slope_tb == nullptr) {
+        pressure_slope_tb    = new double** [number_of_tables];
+        temperature_slope_tb = new double** [number_of_tables];
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            pressure_slope_tb[itable] = Util::mtx_malloc(
+                                    nb_length[itable], e_length[itable]);
+            temperature_slope_tb[itable] = Util::mtx_malloc(
+                                    nb_length[itable], e_length[itable]);
+        }
+    }
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        compute_monotone_slopes(itable, pressure_tb, pressure_slope_tb);
+        compute_monotone_slopes(itable, temperature_tb, temperature_slope_tb);
+    }
+}
+
+
+void EOS_base::compute_monotone_slopes(int table_idx, double ***table,
+                                       double ***slope_table) const {
+    monotone_cubic_slopes(table[table_idx][0], e_length[table_idx],
+                          e_spacing[table_idx], slope_table[table_idx][0]);
+}
+
+
+//! This function replaces the tables at zero mu_B by the coarsest uniform
+//! grid whose monotone cubic interpolation reproduces every entry of the
+//! original table of P(e) and T(e) within the given relative tolerance
+void EOS_base::resample_1D_tables(double tolerance) {
+    if (!has_1D_tables()) {
+        music_message.warning(
+            "EoS resampling is only available for tables at zero mu_B.");
+        return;
+    }
+    set_interpolation_order(3);
+
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        const int N_e        = e_length[itable];
+        const double e0      = e_bounds[itable];
+        const double delta_e = e_spacing[itable];
+        const double e_end   = e0 + (N_e - 1)*delta_e;
+
+        std::vector<double> P(N_e), T(N_e), mP(N_e), mT(N_e);
+        for (int i = 0; i < N_e; i++) {
+            P[i]  = pressure_tb[itable][0][i];
+            T[i]  = temperature_tb[itable][0][i];
+            mP[i] = pressure_slope_tb[itable][0][i];
+            mT[i] = temperature_slope_tb[itable][0][i];
+        }
+
+        std::vector<double> P_new, T_new, mP_new, mT_new;
+        auto resample = [&](const int n) {
+            const double h = (e_end - e0)/(n - 1);
+            P_new.resize(n);
+            T_new.resize(n);
+            mP_new.resize(n);
+            mT_new.resize(n);
+            for (int j = 0; j < n; j++) {
+                const double e_j = (j == n - 1 ? e_end : e0 + j*h);
+                P_new[j] = hermite_cubic(P, mP, e0, delta_e, e_j);
+                T_new[j] = hermite_cubic(T, mT, e0, delta_e, e_j);
+            }
+            monotone_cubic_slopes(P_new.data(), n, h, mP_new.data());
+            monotone_cubic_slopes(T_new.data(), n, h, mT_new.data());
+            double max_err = 0.;
+            for (int i = 0; i < N_e; i++) {
+                const double e_i = e0 + i*delta_e;
+                const double P_i = hermite_cubic(P_new, mP_new, e0, h, e_i);
+                const double T_i = hermite_cubic(T_new, mT_new, e0, h, e_i);
+                max_err = std::max(max_err,
+                    std::abs(P_i - P[i])/(std::abs(P[i]) + 1e-15));
+                max_err = std::max(max_err,
+                    std::abs(T_i - T[i])/(std::abs(T[i]) + 1e-15));
+            }
+            return(max_err);
+        };
+
+        // bisect the number of grid points
+        int n_low  = std::min(N_e, 4);
+        int n_high = N_e;
+        while (n_low < n_high) {
+            const int n_mid = (n_low + n_high)/2;
+            if (resample(n_mid) <= tolerance) {
+                n_high = n_mid;
+            } else {
+                n_low = n_mid + 1;
+            }
+        }
+        const double max_err = resample(n_high);
+        if (n_high == N_e || max_err > tolerance) {
+            music_message << "EoS table " << itable << ": keep all "
+                          << N_e << " points";
+            music_message.flush("info");
+            continue;
+        }
+        music_message << "EoS table " << itable << ": resample "
+                      << N_e << " -> " << n_high
+                      << " points, max relative error = " << max_err;
+        music_message.flush("info");
+
+        Util::mtx_free(pressure_tb[itable], 1, N_e);
+        Util::mtx_free(temperature_tb[itable], 1, N_e);
+        Util::mtx_free(pressure_slope_tb[itable], 1, N_e);
+        Util::mtx_free(temperature_slope_tb[itable], 1, N_e);
+        e_length[itable]  = n_high;
+        e_spacing[itable] = (e_end - e0)/(n_high - 1);
+        pressure_tb[itable]          = Util::mtx_malloc(1, n_high);
+        temperature_tb[itable]       = Util::mtx_malloc(1, n_high);
+        pressure_slope_tb[itable]    = Util::mtx_malloc(1, n_high);
+        temperature_slope_tb[itable] = Util::mtx_malloc(1, n_high);
+        for (int j = 0; j < n_high; j++) {
+            pressure_tb[itable][0][j]          = P_new[j];
+            temperature_tb[itable][0][j]       = T_new[j];
+            pressure_slope_tb[itable][0][j]    = mP_new[j];
+            temperature_slope_tb[itable][0][j] = mT_new[j];
+        }
+    }
+}
+
+
+//! This function outputs the tables at zero mu_B as they are used in
+//! the simulation, e.g. after resampling
+void EOS_base::output_1D_tables(std::string filename_prefix) const {
+    if (!has_1D_tables()) {
+        cout << "output_1D_tables:: no EoS tables at zero mu_B to output."
+             << endl;
+        return;
+    }
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        ostringstream file_name;
+        file_name << filename_prefix << "_" << whichEOS << "_table_"
+                  << itable << ".dat";
+        ofstream of(file_name.str().c_str());
+        of << "#e(GeV/fm^3) P(GeV/fm^3) T(GeV) dP/de" << endl;
+        for (int i = 0; i < e_length[itable]; i++) {
+            const double e_local = e_bounds[itable] + i*e_spacing[itable];
+            const double dpde = p_e_func(e_local, 0.0);
+            of << scientific << setw(18) << setprecision(8)
+               << e_local*hbarc << "   " << pressure_tb[itable][0][i]*hbarc
+               << "   " << temperature_tb[itable][0][i]*hbarc << "   "
+               << dpde << endl;
+        }
+        of.close();
+    }
+}
+
+
+//! This function builds the constant-time lookup for get_table_idx.
+//! The bins are the exponent plus the leading mantissa bits of e. The
+//! number of mantissa bits is increased until every bin holds at most one
+//! table boundary; the linear scan is kept if no such binning is found
+void EOS_base::build_table_idx_lookup() {
+    table_idx_lookup.clear();
+    table_idx_bound.clear();
+    if (number_of_tables < 2) return;
+    for (int itable = 1; itable < number_of_tables; itable++) {
+        if (e_bounds[itable] <= 0. || e_bounds[itable] < e_bounds[itable-1])
+            return;
+    }
+
+    auto get_bits = [](double x) {
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(double));
+        return(bits);
+    };
+    auto get_value = [](uint64_t bits) {
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        return(x);
+    };
+
+    const int max_mantissa_bits = 20;
+    const int64_t max_bins = 1 << 16;
+    for (int n_bits = 0; n_bits <= max_mantissa_bits; n_bits++) {
+        const int shift = 52 - n_bits;
+        // bin 0 takes everything below the first boundary
+        const int64_t key0 = (
+            static_cast<int64_t>(get_bits(e_bounds[1]) >> shift) - 1);
+        const int64_t keyN = static_cast<int64_t>(
+                        get_bits(e_bounds[number_of_tables - 1]) >> shift);
+        const int64_t n_bins = keyN - key0 + 1;
+        if (n_bins > max_bins) break;
+
+        std::vector<int> lookup(n_bins, 0);
+        std::vector<double> bound(n_bins,
+                                  std::numeric_limits<double>::infinity());
+        bool success = true;
+        for (int64_t ibin = 0; ibin < n_bins && success; ibin++) {
+            const double e_low = (
+                ibin == 0 ? 0. : get_value((key0 + ibin) << shift));
+            const double e_high = (
+                ibin == n_bins - 1 ? std::numeric_limits<double>::infinity()
+                : get_value((key0 + ibin + 1) << shift));
+            int n_inside = 0;
+            for (int itable = 1; itable < number_of_tables; itable++) {
+                if (e_bounds[itable] <= e_low) {
+                    lookup[ibin]++;
+                } else if (e_bounds[itable] < e_high) {
+                    bound[ibin] = e_bounds[itable];
+                    n_inside++;
+                }
+            }
+            if (n_inside > 1) success = false;
+        }
+        if (success) {
+            table_idx_shift = shift;
+            table_idx_key0 = key0;
+            table_idx_lookup = lookup;
+            table_idx_bound = bound;
+            return;
+        }
+    }
+    music_message.warning(
+        "EOS table boundaries are too close for the table index lookup, "
+        "use linear search instead.");
+}
+
+
+TEST_CASE("check the table index lookup against the linear search") {
+    // boundaries as in the s95p tables, plus two close ones that need
+    // a few mantissa bits to be separated
+    EOS_base test;
+    test.set_number_of_tables(9);
+    test.resize_table_info_arrays();
+    double bounds[9] = {0.0, 0.0003, 0.0303, 0.3303, 0.34, 3.3303,
+                        30.3303, 330.3303, 330.5};
+    for (int i = 0; i < 9; i++) test.e_bounds[i] = bounds[i];
+
+    std::vector<double> e_list = {-1.0, -0.0, 0.0, 1e-300, 1e300, 1e10};
+    for (int i = 0; i < 9; i++) {
+        e_list.push_back(bounds[i]);
+        e_list.push_back(std::nextafter(bounds[i], 0.0));
+        e_list.push_back(std::nextafter(bounds[i], 1e300));
+    }
+    for (int i = 0; i < 10000; i++) {
+        e_list.push_back(std::pow(10., -6. + 9.*i/10000.));
+    }
+    std::vector<int> idx_linear;
+    for (const auto e: e_list) idx_linear.push_back(test.get_table_idx(e));
+
+    test.build_table_idx_lookup();
+    REQUIRE(test.has_table_idx_lookup());
+    for (unsigned int i = 0; i < e_list.size(); i++) {
+        CHECK(test.get_table_idx(e_list[i]) == idx_linear[i]);
+    }
+    test.set_number_of_tables(0);
+}
+
+
+TEST_CASE("check the linear search for boundaries too close for the lookup") {
+    EOS_base test;
+    test.set_number_of_tables(5);
+    test.resize_table_info_arrays();
+    double bounds[5] = {0.0, 0.0003, 0.3303, 0.33031, 330.5};
+    for (int i = 0; i < 5; i++) test.e_bounds[i] = bounds[i];
+
+    test.build_table_idx_lookup();
+    CHECK(!test.has_table_idx_lookup());
+    std::vector<double> e_list = {-1.0, 0.0, 1e300};
+    for (int i = 0; i < 5; i++) {
+        e_list.push_back(bounds[i]);
+        e_list.push_back(std::nextafter(bounds[i], 0.0));
+        e_list.push_back(std::nextafter(bounds[i], 1e300));
+    }
+    for (const auto e: e_list) {
+        // the table is the one of the last boundary below or at e
+        int idx = 0;
+        for (int i = 1; i < 5; i++) {
+            if (e >= bounds[i]) idx = i;
+        }
+        CHECK(test.get_table_idx(e) == idx);
+    }
+    test.set_number_of_tables(0);
+}
+
+
 void EOS_base::check_eos_no_muB() const {
     // output EoS as function of e
     ostringstream file_name;
@@ -5,6 +5,9 @@
 
 #include "pretty_ostream.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -17,6 +20,16 @@ class EOS_base {
     bool flag_muS;
     bool flag_muC;
 
+    // constant-time lookup of the table index, bins are the leading bits
+    // of the IEEE representation of e, i.e. roughly log-spaced in e
+    int table_idx_shift;
+    int64_t table_idx_key0;
+    std::vector<int> table_idx_lookup;
+    std::vector<double> table_idx_bound;
+
+    //! 1: linear, 3: monotone cubic (Hermite) interpolation in e
+    int interpolation_order = 1;
+
  public:
     pretty_ostream music_message;
     std::vector<double> nb_bounds;
@@ -34,6 +47,16 @@ class EOS_base {
     double ***mu_S_tb;
     double ***mu_C_tb;
 
+    // node derivatives d/de of the tables at zero mu_B,
+    // used by the cubic interpolation
+    double ***pressure_slope_tb    = nullptr;
+    double ***temperature_slope_tb = nullptr;
+
+    // dP/de, dP/drhob and the clamped cs^2 at the table nodes
+    double ***dpde_tb    = nullptr;
+    double ***dpdrhob_tb = nullptr;
+    double ***cs2_tb     = nullptr;
+
     EOS_base() = default;
     virtual ~EOS_base();
 
@@ -59,14 +82,38 @@ class EOS_base {
     double get_eps_max() const {return(eps_max);}
 
     double interpolate1D(double e, int table_idx, double ***table) const;
+    double interpolate1D_cubic(double e, int table_idx, double ***table,
+                               double ***slope_table) const;
+    double interpolate1D_cubic_derivative(double e, int table_idx,
+                                          double ***table,
+                                          double ***slope_table) const;
+
+    bool has_1D_tables() const;
+    void set_interpolation_order(int order);
+    int  get_interpolation_order() const {return(interpolation_order);}
+    void compute_monotone_slopes(int table_idx, double ***table,
+                                 double ***slope_table) const;
+    void resample_1D_tables(double tolerance);
+    void output_1D_tables(std::string filename_prefix) const;
     double interpolate2D(double e, double rhob, int table_idx, double ***table) const;
 
     int    get_table_idx(double e) const;
+    void   build_table_idx_lookup();
+    bool   has_table_idx_lookup() const {return(!table_idx_lookup.empty());}
     double get_entropy  (double epsilon, double rhob) const;
+    //! entropy density with the pressure P and the temperature T at
+    //! (epsilon, rhob) already known, so that they are not looked up again
+    double get_entropy  (double epsilon, double rhob,
+                         double P, double T) const;
 
     double calculate_velocity_of_sound_sq(double e, double rhob) const;
     double get_dpOverde3(double e, double rhob) const;
     double get_dpOverdrhob2(double e, double rhob) const;
+
+    void   build_derivative_tables();
+    double interpolate_dpde   (double e, double rhob) const;
+    double interpolate_dpdrhob(double e, double rhob) const;
+    double interpolate_cs2    (double e, double rhob) const;
     double get_s2e_finite_rhob(double s, double rhob) const;
     double get_T2e_finite_rhob(const double T, const double rhob) const;
 
@@ -91,4 +138,157 @@ class EOS_base {
 };
 
 
+// the table lookups are inline so that they can be folded into the
+// hydro kernels when the EOS class is known at compile time
+inline double EOS_base::interpolate1D(double e, int table_idx, double ***table) const {
+// This is a generic linear interpolation routine for EOS at zero mu_B
+// it assumes the class has already read in
+//        P(e), T(e), s(e)
+// as one-dimensional arrays on an equally spacing lattice grid
+// units: e is in 1/fm^4
+    //double local_ed = e*hbarc;  // [GeV/fm^3]
+    double local_ed = e;
+
+    const double e0       = e_bounds[table_idx];
+    const double delta_e  = e_spacing[table_idx];
+    const int N_e         = e_length[table_idx];
+
+    // compute the indices
+    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
+
+    // treatment for overflow, use the last two points to do extrapolation
+    idx_e  = std::min(N_e - 2, idx_e);
+
+    // check underflow
+    idx_e  = std::max(0, idx_e);
+
+    const double frac_e = (local_ed - (idx_e*delta_e + e0))/delta_e;
+
+    double result;
+    double temp1 = table[table_idx][0][idx_e];
+    double temp2 = table[table_idx][0][idx_e + 1];
+    result = temp1*(1. - frac_e) + temp2*frac_e;
+    return(result);
+}
+
+
+//! Monotone cubic (Hermite) interpolation in e for the tables at zero mu_B.
+//! Outside of the table the function is extrapolated linearly
+//! with the slope at the last node
+inline double EOS_base::interpolate1D_cubic(double e, int table_idx,
+                                            double ***table,
+                                            double ***slope_table) const {
+    const double e0      = e_bounds[table_idx];
+    const double delta_e = e_spacing[table_idx];
+    const int N_e        = e_length[table_idx];
+
+    int idx_e = static_cast<int>((e - e0)/delta_e);
+    idx_e = std::max(0, std::min(N_e - 2, idx_e));
+    const double t = (e - (idx_e*delta_e + e0))/delta_e;
+
+    const double y0 = table[table_idx][0][idx_e];
+    const double y1 = table[table_idx][0][idx_e + 1];
+    const double m0 = slope_table[table_idx][0][idx_e]*delta_e;
+    const double m1 = slope_table[table_idx][0][idx_e + 1]*delta_e;
+    if (t < 0.) return(y0 + m0*t);
+    if (t > 1.) return(y1 + m1*(t - 1.));
+
+    const double t2 = t*t;
+    const double t3 = t2*t;
+    return(  (2.*t3 - 3.*t2 + 1.)*y0 + (t3 - 2.*t2 + t)*m0
+           + (-2.*t3 + 3.*t2)*y1 + (t3 - t2)*m1);
+}
+
+
+//! The derivative d/de of the monotone cubic interpolation
+inline double EOS_base::interpolate1D_cubic_derivative(
+        double e, int table_idx, double ***table,
+        double ***slope_table) const {
+    const double e0      = e_bounds[table_idx];
+    const double delta_e = e_spacing[table_idx];
+    const int N_e        = e_length[table_idx];
+
+    int idx_e = static_cast<int>((e - e0)/delta_e);
+    idx_e = std::max(0, std::min(N_e - 2, idx_e));
+    const double t = (e - (idx_e*delta_e + e0))/delta_e;
+
+    if (t < 0.) return(slope_table[table_idx][0][idx_e]);
+    if (t > 1.) return(slope_table[table_idx][0][idx_e + 1]);
+
+    const double y0 = table[table_idx][0][idx_e];
+    const double y1 = table[table_idx][0][idx_e + 1];
+    const double m0 = slope_table[table_idx][0][idx_e]*delta_e;
+    const double m1 = slope_table[table_idx][0][idx_e + 1]*delta_e;
+    const double t2 = t*t;
+    return((  (6.*t2 - 6.*t)*(y0 - y1) + (3.*t2 - 4.*t + 1.)*m0
+            + (3.*t2 - 2.*t)*m1)/delta_e);
+}
+
+
+inline double EOS_base::interpolate2D(double e, double rhob, int table_idx, double ***table) const {
+// This is a generic bilinear interpolation routine for EOS at finite mu_B
+// it assumes the class has already read in
+//        P(e, rho_b), T(e, rho_b), s(e, rho_b), mu_b(e, rho_b)
+// as two-dimensional arrays on an equally spacing lattice grid
+// units: e is in 1/fm^4, rhob is in 1/fm^3
+    //double local_ed = e*hbarc;  // [GeV/fm^3]
+    double local_ed = e;
+    double local_nb = rhob;     // [1/fm^3]
+
+    double e0       = e_bounds[table_idx];
+    double nb0      = nb_bounds[table_idx];
+    double delta_e  = e_spacing[table_idx];
+    double delta_nb = nb_spacing[table_idx];
+
+    int N_e  = e_length[table_idx];
+    int N_nb = nb_length[table_idx];
+
+    // compute the indices
+    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
+    int idx_nb = static_cast<int>((local_nb - nb0)/delta_nb);
+
+    // treatment for overflow, use the last two points to do extrapolation
+    idx_e  = std::min(N_e - 2, idx_e);
+    idx_nb = std::min(N_nb - 2, idx_nb);
+
+    // check underflow
+    idx_e  = std::max(0, idx_e);
+    idx_nb = std::max(0, idx_nb);
+
+    double frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
+    double frac_rhob = (local_nb - (idx_nb*delta_nb + nb0))/delta_nb;
+
+    double result;
+    double temp1 = table[table_idx][idx_nb][idx_e];
+    double temp2 = table[table_idx][idx_nb][idx_e + 1];
+    double temp3 = table[table_idx][idx_nb + 1][idx_e + 1];
+    double temp4 = table[table_idx][idx_nb + 1][idx_e];
+    result = ((temp1*(1. - frac_e) + temp2*frac_e)*(1. - frac_rhob)
+              + (temp3*frac_e + temp4*(1. - frac_e))*frac_rhob);
+    return(result);
+}
+
+
+inline int EOS_base::get_table_idx(double e) const {
+    if (table_idx_lookup.empty()) {
+        // no lookup index, scan the table boundaries
+        for (int itable = 1; itable < number_of_tables; itable++) {
+            if (e < e_bounds[itable]) {
+                return(itable - 1);
+            }
+        }
+        return(std::max(0, number_of_tables - 1));
+    }
+    // every bin holds at most one table boundary
+    const double e_pos = (e > 0. ? e : 0.);
+    uint64_t e_bits;
+    std::memcpy(&e_bits, &e_pos, sizeof(double));
+    int64_t key = (static_cast<int64_t>(e_bits >> table_idx_shift)
+                   - table_idx_key0);
+    key = std::max<int64_t>(0, std::min<int64_t>(
+                            key, static_cast<int64_t>(table_idx_lookup.size()) - 1));
+    return(table_idx_lookup[key] + (e >= table_idx_bound[key]));
+}
+
+
 #endif  // SRC_EOS_BASE_H_
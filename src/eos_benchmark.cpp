@@ -0,0 +1,440 @@
+// Copyright @ Bjoern Schenke, Sangyong Jeon, Charles Gale, and Chun Shen
+// Micro-benchmark and accuracy check for the EoS lookups
+//
+// usage: EOS_benchmark.e [-n N] [-r repetitions] [-o order] [-t tolerance]
+//                        [-d] [-a max_error] [eos_id ...]
+//
+// For every EoS it times get_pressure, get_cs2 and get_temperature with
+// random (log-uniform) and coherent (sorted) access patterns, through the
+// scalar interface (independent lookups and a dependent chain) and the
+// batched one. It reports lookups/s, ns/lookup and, on x86, reference
+// cycles (time stamp counter ticks) per lookup, the median of -r timed
+// repetitions. P and T are then checked
+// against the original tables, at the table nodes and at the midpoints
+// between neighbouring nodes (where the reference is the linear
+// interpolation of the two nodes). A configured EoS (interpolation order,
+// resampling, -d for the derivative tables) is also compared with the
+// default linear interpolation on the original tables. With -a the
+// program exits with 1 if a relative error at the nodes or against the
+// linear interpolation is larger than max_error.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define EOS_BENCHMARK_RDTSC
+#endif
+
+#include "eos.h"
+#include "util.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+//! returns a file that has to exist for the EoS tables of eos_id,
+//! or "" if the EoS does not need any table
+string eos_table_path(const int eos_id) {
+    const char *pre_envPath = getenv("HYDROPROGRAMPATH");
+    string envPath = (pre_envPath == 0) ? "." : pre_envPath;
+    switch (eos_id) {
+        case 1:  return(envPath + "/EOS/EOS-Q");
+        case 2:  return(envPath + "/EOS/s95p-v1");
+        case 3:  return(envPath + "/EOS/s95p-PCE-v1");
+        case 4:  return(envPath + "/EOS/s95p-PCE155");
+        case 5:  return(envPath + "/EOS/s95p-PCE160");
+        case 6:  return(envPath + "/EOS/s95p-PCE165-v0");
+        case 7:  return(envPath + "/EOS/s95p-v1.2");
+        case 9:  return(envPath + "/EOS/hotQCD/hrg_hotqcd_eos_binary.dat");
+        case 10: return(envPath + "/EOS/neos_2");
+        case 11: return(envPath + "/EOS/neos_3");
+        case 12: return(envPath + "/EOS/neos_b");
+        case 13: return(envPath + "/EOS/neos_bs");
+        case 14: return(envPath + "/EOS/neos_bqs");
+        case 17: return("./EOS/BEST");
+        default: return("");
+    }
+}
+
+
+struct Samples {
+    vector<double> e;
+    vector<double> rhob;
+};
+
+
+//! log-uniform energy densities in [e_min, e_max] (1/fm^4). For EoS with
+//! a baryon density axis rhob is a fraction of e^{3/4}, so that mu_B/T
+//! stays inside the tables.
+Samples make_samples(const int n, const double e_min, const double e_max,
+                     const bool flag_muB, const bool sorted,
+                     std::mt19937 &rng) {
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    Samples samples;
+    samples.e.resize(n);
+    samples.rhob.resize(n, 0.);
+    const double log_ratio = log(e_max/e_min);
+    for (int i = 0; i < n; i++) {
+        samples.e[i] = e_min*exp(uniform(rng)*log_ratio);
+    }
+    if (sorted) std::sort(samples.e.begin(), samples.e.end());
+    if (flag_muB) {
+        for (int i = 0; i < n; i++) {
+            samples.rhob[i] = 0.05*uniform(rng)*pow(samples.e[i], 0.75);
+        }
+    }
+    return(samples);
+}
+
+
+struct Timing {
+    double lookups_per_s;
+    double ns_per_lookup;
+    double ref_cycles_per_lookup;
+};
+
+
+//! number of timed repetitions of every kernel, the median is reported
+int n_repetitions = 5;
+
+
+//! times n_repetitions calls of kernel, which does n lookups, and returns
+//! the median. The reference cycles are the ticks of the time stamp
+//! counter, which runs at a fixed frequency and not at the core clock
+template <class Kernel>
+Timing time_kernel(Kernel kernel, const int n) {
+    kernel();  // warm up the caches and the branch predictors
+    vector<Timing> timings(n_repetitions);
+    for (auto &timing : timings) {
+#ifdef EOS_BENCHMARK_RDTSC
+        const unsigned long long c_start = __rdtsc();
+#endif
+        auto t_start = std::chrono::steady_clock::now();
+        kernel();
+        auto t_end = std::chrono::steady_clock::now();
+        timing.ns_per_lookup = (
+            std::chrono::duration<double, std::nano>(t_end - t_start).count()
+            /n);
+        timing.lookups_per_s = 1e9/timing.ns_per_lookup;
+#ifdef EOS_BENCHMARK_RDTSC
+        timing.ref_cycles_per_lookup = (
+            static_cast<double>(__rdtsc() - c_start)/n);
+#else
+        timing.ref_cycles_per_lookup = 0.;
+#endif
+    }
+    std::sort(timings.begin(), timings.end(),
+              [](const Timing &a, const Timing &b) {
+                  return(a.ns_per_lookup < b.ns_per_lookup);
+              });
+    return(timings[n_repetitions/2]);
+}
+
+
+void print_timing_header() {
+    cout << "    " << std::left << std::setw(30) << "" << std::right
+         << std::setw(14) << "lookups/s" << std::setw(12) << "ns/lookup";
+#ifdef EOS_BENCHMARK_RDTSC
+    cout << std::setw(22) << "ref. cycles/lookup";
+#endif
+    cout << endl;
+}
+
+
+void print_timing(const string &label, const Timing &timing) {
+    cout << "    " << std::left << std::setw(30) << label << std::right
+         << std::setw(14) << std::scientific << std::setprecision(3)
+         << timing.lookups_per_s
+         << std::setw(12) << std::fixed << std::setprecision(2)
+         << timing.ns_per_lookup;
+#ifdef EOS_BENCHMARK_RDTSC
+    cout << std::setw(22) << timing.ref_cycles_per_lookup;
+#endif
+    cout << endl;
+}
+
+
+double sink = 0.;
+
+//! times the lookups of P, cs^2 and T for the samples. The scalar loops
+//! look up every sample independently (throughput), the chained loops
+//! feed every result into the next argument (latency of one lookup), and
+//! the batch calls use the array interface
+void benchmark_pattern(const EOS &eos, const Samples &samples,
+                       const string &pattern) {
+    const int n = samples.e.size();
+    const double *e = samples.e.data();
+    const double *rhob = samples.rhob.data();
+    vector<double> out(n);
+
+    auto scalar_pressure = [&]() {
+        for (int i = 0; i < n; i++) {
+            out[i] = eos.get_pressure(e[i], rhob[i]);
+        }
+        sink += out[n - 1];
+    };
+    auto scalar_cs2 = [&]() {
+        for (int i = 0; i < n; i++) {
+            out[i] = eos.get_cs2(e[i], rhob[i]);
+        }
+        sink += out[n - 1];
+    };
+    auto scalar_temperature = [&]() {
+        for (int i = 0; i < n; i++) {
+            out[i] = eos.get_temperature(e[i], rhob[i]);
+        }
+        sink += out[n - 1];
+    };
+    auto chained_pressure = [&]() {
+        double carry = 0.;
+        for (int i = 0; i < n; i++) {
+            carry = eos.get_pressure(e[i] + 1e-30*carry, rhob[i]);
+        }
+        sink += carry;
+    };
+    auto chained_cs2 = [&]() {
+        double carry = 0.;
+        for (int i = 0; i < n; i++) {
+            carry = eos.get_cs2(e[i] + 1e-30*carry, rhob[i]);
+        }
+        sink += carry;
+    };
+    auto chained_temperature = [&]() {
+        double carry = 0.;
+        for (int i = 0; i < n; i++) {
+            carry = eos.get_temperature(e[i] + 1e-30*carry, rhob[i]);
+        }
+        sink += carry;
+    };
+    auto batch_pressure = [&]() {
+        eos.get_pressure(e, rhob, out.data(), n);
+        sink += out[n - 1];
+    };
+    auto batch_cs2 = [&]() {
+        eos.get_cs2(e, rhob, out.data(), n);
+        sink += out[n - 1];
+    };
+    auto batch_temperature = [&]() {
+        eos.get_temperature(e, rhob, out.data(), n);
+        sink += out[n - 1];
+    };
+
+    cout << "  " << pattern << " access:" << endl;
+    print_timing_header();
+    print_timing("get_pressure (scalar)", time_kernel(scalar_pressure, n));
+    print_timing("get_pressure (chained)", time_kernel(chained_pressure, n));
+    print_timing("get_pressure (batch)", time_kernel(batch_pressure, n));
+    print_timing("get_cs2 (scalar)", time_kernel(scalar_cs2, n));
+    print_timing("get_cs2 (chained)", time_kernel(chained_cs2, n));
+    print_timing("get_cs2 (batch)", time_kernel(batch_cs2, n));
+    print_timing("get_temperature (scalar)",
+                 time_kernel(scalar_temperature, n));
+    print_timing("get_temperature (chained)",
+                 time_kernel(chained_temperature, n));
+    print_timing("get_temperature (batch)",
+                 time_kernel(batch_temperature, n));
+}
+
+
+double relative_error(const double value, const double reference) {
+    return(std::abs(value - reference)
+           /std::max(std::abs(reference), 1e-15));
+}
+
+
+//! compares eos against the reference EoS and returns the largest
+//! relative error in P, T and cs^2
+double check_accuracy(const EOS &eos, const EOS &eos_ref,
+                      const Samples &samples) {
+    double err_p = 0., err_t = 0., err_cs2 = 0.;
+    for (unsigned int i = 0; i < samples.e.size(); i++) {
+        const double e = samples.e[i];
+        const double rhob = samples.rhob[i];
+        err_p = std::max(err_p, relative_error(eos.get_pressure(e, rhob),
+                                               eos_ref.get_pressure(e, rhob)));
+        err_t = std::max(err_t,
+                         relative_error(eos.get_temperature(e, rhob),
+                                        eos_ref.get_temperature(e, rhob)));
+        err_cs2 = std::max(err_cs2,
+                           relative_error(eos.get_cs2(e, rhob),
+                                          eos_ref.get_cs2(e, rhob)));
+    }
+    cout << "  max relative error vs. linear interpolation: "
+         << std::scientific << std::setprecision(3)
+         << "P " << err_p << ", T " << err_t << ", cs^2 " << err_cs2
+         << std::fixed << endl;
+    return(std::max(err_p, std::max(err_t, err_cs2)));
+}
+
+//! compares P and T of eos with the original tables of eos_ref at the
+//! table nodes and at the midpoints between neighbouring nodes in e and
+//! rhob, for e in [e_min, e_max]. Nodes where the lookup goes to the next
+//! table and empty table entries are skipped. Returns the largest relative
+//! error at the nodes
+double check_table_accuracy(const EOS &eos, const EOS &eos_ref,
+                            const double e_min, const double e_max) {
+    const EOS_base &tables = eos_ref.get_eos_impl<EOS_base>();
+    double err_p_node = 0., err_t_node = 0.;
+    double err_p_mid  = 0., err_t_mid  = 0.;
+    auto check = [&](const double e, const double rhob,
+                     const double p_ref, const double t_ref,
+                     double &err_p, double &err_t) {
+        err_p = std::max(err_p, relative_error(eos.get_pressure(e, rhob),
+                                               p_ref));
+        err_t = std::max(err_t, relative_error(eos.get_temperature(e, rhob),
+                                               t_ref));
+    };
+    for (int itable = 0; itable < tables.get_number_of_tables(); itable++) {
+        const int N_e  = tables.e_length[itable];
+        const int N_nb = tables.nb_length[itable];
+        const double e0  = tables.e_bounds[itable];
+        const double nb0 = tables.nb_bounds[itable];
+        const double de  = tables.e_spacing[itable];
+        const double dnb = tables.nb_spacing[itable];
+        double **P = tables.pressure_tb[itable];
+        double **T = tables.temperature_tb[itable];
+        // the unphysical corners of some tables are filled with zeros,
+        // where the EoS returns its lower cutoff instead
+        auto physical = [&](const int i, const int j) {
+            return(P[i][j] > 0. && T[i][j] > 0.);
+        };
+        for (int i = 0; i < N_nb; i++) {
+            const double rhob = nb0 + i*dnb;
+            for (int j = 0; j < N_e; j++) {
+                const double e = e0 + j*de;
+                if (e < e_min || e > e_max || !physical(i, j)
+                        || tables.get_table_idx(e) != itable) {
+                    continue;
+                }
+                check(e, rhob, P[i][j], T[i][j], err_p_node, err_t_node);
+                if (j + 1 < N_e && physical(i, j + 1)
+                        && tables.get_table_idx(e + de) == itable) {
+                    check(e + 0.5*de, rhob, 0.5*(P[i][j] + P[i][j+1]),
+                          0.5*(T[i][j] + T[i][j+1]), err_p_mid, err_t_mid);
+                }
+                if (i + 1 < N_nb && physical(i + 1, j)) {
+                    check(e, rhob + 0.5*dnb, 0.5*(P[i][j] + P[i+1][j]),
+                          0.5*(T[i][j] + T[i+1][j]), err_p_mid, err_t_mid);
+                }
+            }
+        }
+    }
+    cout << "  max relative error vs. the tables: "
+         << std::scientific << std::setprecision(3)
+         << "nodes P " << err_p_node << ", T " << err_t_node
+         << "; midpoints P " << err_p_mid << ", T " << err_t_mid
+         << std::fixed << endl;
+    return(std::max(err_p_node, err_t_node));
+}
+
+}  // namespace
+
+
+int main(int argc, char *argv[]) {
+    int n_samples = 1000000;
+    int interpolation_order = 1;
+    double resample_tolerance = 0.;
+    bool derivative_tables = false;
+    double max_error = -1.;
+    vector<int> eos_ids;
+    for (int i = 1; i < argc; i++) {
+        const string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            n_samples = std::atoi(argv[++i]);
+        } else if (arg == "-r" && i + 1 < argc) {
+            n_repetitions = std::atoi(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            interpolation_order = std::atoi(argv[++i]);
+        } else if (arg == "-t" && i + 1 < argc) {
+            resample_tolerance = std::atof(argv[++i]);
+        } else if (arg == "-d") {
+            derivative_tables = true;
+        } else if (arg == "-a" && i + 1 < argc) {
+            max_error = std::atof(argv[++i]);
+        } else {
+            eos_ids.push_back(std::atoi(argv[i]));
+        }
+    }
+    if (eos_ids.empty()) {
+        // the EoS that are covered in tests/test_eos
+        eos_ids = {4, 7, 8, 9, 10, 11, 12, 13, 14};
+    }
+    if (n_samples < 1) {
+        cout << "EOS_benchmark: -n needs a positive number" << endl;
+        exit(1);
+    }
+    if (n_repetitions < 1) {
+        cout << "EOS_benchmark: -r needs a positive number" << endl;
+        exit(1);
+    }
+    if (resample_tolerance > 0. && interpolation_order != 3) {
+        cout << "EOS_benchmark: -t needs -o 3" << endl;
+        exit(1);
+    }
+
+    // range of the tests: 1e-3 - 100 GeV/fm^3
+    const double e_min = 1e-3/Util::hbarc;
+    const double e_max = 1e2/Util::hbarc;
+
+    bool passed = true;
+    for (const auto eos_id : eos_ids) {
+        const string table_path = eos_table_path(eos_id);
+        if (table_path != "" && !Util::IsFile(table_path)) {
+            cout << "EoS " << eos_id << ": tables not found ("
+                 << table_path << "), skipped" << endl;
+            continue;
+        }
+        EOS eos(eos_id, interpolation_order, resample_tolerance,
+                derivative_tables);
+        const bool flag_muB = eos.get_eos_impl<EOS_base>().get_flag_muB();
+        const double e_upper = std::min(e_max, 0.99*eos.get_eps_max());
+
+        cout << "EoS " << eos_id << " (interpolation order "
+             << interpolation_order;
+        if (resample_tolerance > 0.) {
+            cout << ", resampled with tolerance " << resample_tolerance;
+        }
+        if (derivative_tables) cout << ", derivative tables";
+        cout << "), " << n_samples << " lookups per test" << endl;
+
+        std::mt19937 rng(eos_id);
+        const Samples random_samples = make_samples(
+                    n_samples, e_min, e_upper, flag_muB, false, rng);
+        const Samples sorted_samples = make_samples(
+                    n_samples, e_min, e_upper, flag_muB, true, rng);
+        benchmark_pattern(eos, random_samples, "random");
+        benchmark_pattern(eos, sorted_samples, "coherent");
+
+        if (table_path == "") {
+            cout << "  no tables, accuracy not checked" << endl;
+            continue;
+        }
+        EOS eos_ref(eos_id);
+        double error = check_table_accuracy(eos, eos_ref, e_min, e_upper);
+        if (interpolation_order != 1 || resample_tolerance > 0.
+                || derivative_tables) {
+            const Samples check_samples = make_samples(
+                std::min(n_samples, 100000), e_min, e_upper, flag_muB,
+                false, rng);
+            error = std::max(error,
+                             check_accuracy(eos, eos_ref, check_samples));
+        }
+        if (max_error > 0. && error > max_error) {
+            cout << "  FAILED: error is larger than " << max_error << endl;
+            passed = false;
+        }
+    }
+    if (sink == 0.) cout << endl;  // keeps the timed loops alive
+    return(passed ? 0 : 1);
+}
@@ -106,12 +106,12 @@ void EOS_BEST::initialize_eos() {
 
 
 double EOS_BEST::p_e_func(double e, double rhob) const {
-    return(get_dpOverde3(e, rhob));
+    return(interpolate_dpde(e, rhob));
 }
 
 
 double EOS_BEST::p_rho_func(double e, double rhob) const {
-    return(get_dpOverdrhob2(e, rhob));
+    return(interpolate_dpdrhob(e, rhob));
 }
 
 
@@ -5,7 +5,7 @@
 
 #include "eos_base.h"
 
-class EOS_hotQCD : public EOS_base {
+class EOS_hotQCD final : public EOS_base {
  private:
    
  public:
@@ -14,7 +14,13 @@ class EOS_hotQCD : public EOS_base {
     void initialize_eos();
     double p_e_func       (double e, double rhob) const;
     double get_temperature(double e, double rhob) const;
-    double get_pressure   (double e, double rhob) const;
+    //! returns the local pressure in [1/fm^4], inlined for the hydro kernels
+    double get_pressure   (double e, double rhob) const {
+        double f = (get_interpolation_order() == 3
+            ? interpolate1D_cubic(e, 0, pressure_tb, pressure_slope_tb)
+            : interpolate1D(e, 0, pressure_tb));  // 1/fm^4
+        return(std::max(1e-15, f));
+    }
     double get_s2e        (double s, double rhob) const;
     double get_T2e        (double T, double rhob) const;
 
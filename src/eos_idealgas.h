@@ -5,7 +5,7 @@
 
 #include "eos_base.h"
 
-class EOS_idealgas : public EOS_base {
+class EOS_idealgas final : public EOS_base {
  private:
      double Nc;
      double Nf;
@@ -229,12 +229,12 @@ void EOS_neos::initialize_eos() {
 
 
 double EOS_neos::p_e_func(double e, double rhob) const {
-    return(get_dpOverde3(e, rhob));
+    return(interpolate_dpde(e, rhob));
 }
 
 
 double EOS_neos::p_rho_func(double e, double rhob) const {
-    return(get_dpOverdrhob2(e, rhob));
+    return(interpolate_dpdrhob(e, rhob));
 }
 
 
@@ -249,16 +249,6 @@ double EOS_neos::get_temperature(double e, double rhob) const {
 }
 
 
-//! This function returns the local pressure in [1/fm^4]
-//! the input local energy density [1/fm^4], rhob [1/fm^3]
-double EOS_neos::get_pressure(double e, double rhob) const {
-    int table_idx = get_table_idx(e);
-    double f = interpolate2D(e, std::abs(rhob), table_idx, pressure_tb);
-    f = std::max(1e-15, f);
-    return(f);
-}
-
-
 //! This function returns the local baryon chemical potential  mu_B in [1/fm]
 //! input local energy density eps [1/fm^4] and rhob [1/fm^3]
 double EOS_neos::get_muB(double e, double rhob) const {
@@ -4,8 +4,9 @@
 #define SRC_EOS_neos_H_
 
 #include "eos_base.h"
+#include <cmath>
 
-class EOS_neos : public EOS_base {
+class EOS_neos final : public EOS_base {
  private:
     const int eos_id;
    
@@ -20,7 +21,12 @@ class EOS_neos : public EOS_base {
     double get_muB        (double e, double rhob) const;
     double get_muS        (double e, double rhob) const;
     double get_muC        (double e, double rhob) const;
-    double get_pressure   (double e, double rhob) const;
+    //! returns the local pressure in [1/fm^4], inlined for the hydro kernels
+    double get_pressure   (double e, double rhob) const {
+        int table_idx = get_table_idx(e);
+        double f = interpolate2D(e, std::abs(rhob), table_idx, pressure_tb);
+        return(std::max(1e-15, f));
+    }
     double get_s2e        (double s, double rhob) const;
 
     void check_eos() const {check_eos_with_finite_muB();}
@@ -124,7 +124,12 @@ void EOS_s95p::initialize_eos() {
 
 
 double EOS_s95p::p_e_func(double e, double rhob) const {
-    return(get_dpOverde3(e, rhob));
+    if (get_interpolation_order() == 3) {
+        int table_idx = get_table_idx(e);
+        return(interpolate1D_cubic_derivative(e, table_idx, pressure_tb,
+                                              pressure_slope_tb));
+    }
+    return(interpolate_dpde(e, rhob));
 }
 
 
@@ -132,7 +137,10 @@ double EOS_s95p::p_e_func(double e, double rhob) const {
 //! input local energy density eps [1/fm^4] and rhob [1/fm^3]
 double EOS_s95p::get_temperature(double e, double rhob) const {
     int table_idx = get_table_idx(e);
-    double T = interpolate1D(e, table_idx, temperature_tb);  // 1/fm
+    double T = (get_interpolation_order() == 3
+        ? interpolate1D_cubic(e, table_idx, temperature_tb,
+                              temperature_slope_tb)
+        : interpolate1D(e, table_idx, temperature_tb));  // 1/fm
     return(std::max(1e-15, T));
 }
 
@@ -141,7 +149,9 @@ double EOS_s95p::get_temperature(double e, double rhob) const {
 //! the input local energy density [1/fm^4], rhob [1/fm^3]
 double EOS_s95p::get_pressure(double e, double rhob) const {
     int table_idx = get_table_idx(e);
-    double f = interpolate1D(e, table_idx, pressure_tb);  // 1/fm^4
+    double f = (get_interpolation_order() == 3
+        ? interpolate1D_cubic(e, table_idx, pressure_tb, pressure_slope_tb)
+        : interpolate1D(e, table_idx, pressure_tb));  // 1/fm^4
     return(std::max(1e-15, f));
 }
 
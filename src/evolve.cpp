@@ -5,6 +5,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <cmath>
 #include <string>
@@ -35,6 +36,13 @@ Evolve::Evolve(const EOS &eosIn, const InitData &DATA_in,
     hydro_source_terms_ptr = hydro_source_ptr_in;
 }
 
+
+void Evolve::set_hydro_source_terms(
+        std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) {
+    hydro_source_terms_ptr = hydro_source_ptr_in;
+    advance.set_hydro_source_terms(hydro_source_ptr_in);
+}
+
 // master control function for hydrodynamic evolution
 int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                      SCGrid &arena_future, HydroinfoMUSIC &hydro_info_ptr) {
@@ -70,9 +78,12 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
     GridPointer ap_current(&arena_current, closer);
     GridPointer ap_future (&arena_future, closer);
 
-    SCGrid arena_freezeout(arena_current.nX(),
-                           arena_current.nY(),
-                           arena_current.nEta());
+    // the copy of the previous freeze-out step is only needed
+    // to find the freeze-out surface
+    if (freezeout_flag == 1) {
+        arena_freezeout.reset(arena_current.nX(), arena_current.nY(),
+                              arena_current.nEta());
+    }
 
     double T_max = -1;
     for (int it = 0; it <= itmax; it++) {
@@ -82,7 +93,7 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
             hydro_source_terms_ptr.lock()->prepare_list_for_current_tau_frame(tau);
         }
         // store initial conditions
-        if (it == it_start) {
+        if (it == it_start && freezeout_flag == 1) {
             store_previous_step_for_freezeout(*ap_current, arena_freezeout);
         }
 
@@ -180,6 +191,17 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                       << " Done time step " << it << "/" << itmax
                       << " tau = " << tau << " fm/c";
         music_message.flush("info");
+        if (DATA.echo_level > 5) {
+            const auto stats = advance.get_reconst_statistics();
+            music_message << "Reconstruction: " << stats.n_cells
+                          << " cells, "
+                          << (static_cast<double>(stats.n_iterations)
+                              /std::max(stats.n_cells, 1L))
+                          << " Newton iterations per cell, "
+                          << stats.n_failures << " reverted";
+            music_message.flush("info");
+        }
+        advance.reset_reconst_statistics();
         if (frozen == 1) {
             if (DATA.outputEvolutionData == 0 && DATA.output_movie_flag == 0) {
                 break;
@@ -207,21 +229,66 @@ void Evolve::store_previous_step_for_freezeout(SCGrid &arena_current,
 
 void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future) {
     // control function for Runge-Kutta evolution in tau
-    // loop over Runge-Kutta steps
+    // loop over Runge-Kutta stages. After the first stage arena_prev holds
+    // the beginning of the time step and arena_current the latest stage,
+    // which is all the stages of the Shu-Osher schemes need
+    if (DATA.temporal_blocking_slab > 0 && rk_order > 1
+            && arena_current->nEta() > DATA.temporal_blocking_slab) {
+        AdvanceRK_blocked(tau, arena_prev, arena_current, arena_future);
+        return;
+    }
     for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
         advance.AdvanceIt(tau, *arena_prev, *arena_current, *arena_future,
                           rk_flag);
-        if (rk_flag == 0) {
-            auto temp     = std::move(arena_prev);
-            arena_prev    = std::move(arena_current);
-            arena_current = std::move(arena_future);
-            arena_future  = std::move(temp);
-        } else {
-            std::swap(arena_current, arena_future);
-        }
+        rotate_arenas(rk_flag, arena_prev, arena_current, arena_future);
     }  /* loop over rk_flag */
 }
 
+//! Runge-Kutta time step with temporal blocking: the grid is cut into slabs
+//! of temporal_blocking_slab cells in eta, and the stages run as a wavefront
+//! over the slabs. A stage on a slab only needs the previous stage on the
+//! slab and within the stencil around it, so stage rk_flag can follow
+//! stage rk_flag - 1 at a distance of a few slabs, while those slabs are
+//! still in the cache, instead of after a full sweep over the grid.
+//! The stages write into the grids in the same order as AdvanceRK: a grid
+//! is only overwritten behind the last stage that reads it
+void Evolve::AdvanceRK_blocked(double tau, GridPointer &arena_prev,
+                               GridPointer &arena_current,
+                               GridPointer &arena_future) {
+    // the KT stencil reaches two cells in every direction
+    const int stencil_radius = 2;
+    const int neta    = arena_current->nEta();
+    const int slab    = DATA.temporal_blocking_slab;
+    const int n_slabs = (neta + slab - 1)/slab;
+    const int lag     = (stencil_radius + slab - 1)/slab;
+
+    // grids (prev, current, future) of every stage
+    std::vector<std::array<SCGrid*, 3>> stage_arenas(rk_order);
+    SCGrid *prev    = arena_prev.get();
+    SCGrid *current = arena_current.get();
+    SCGrid *future  = arena_future.get();
+    for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
+        stage_arenas[rk_flag] = {prev, current, future};
+        rotate_arenas(rk_flag, prev, current, future);
+    }
+
+    for (int k = 0; k < n_slabs + (rk_order - 1)*lag; k++) {
+        for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
+            const int islab = k - rk_flag*lag;
+            if (islab < 0 || islab >= n_slabs) continue;
+            const int ieta_begin = islab*slab;
+            const int ieta_end   = std::min(neta, ieta_begin + slab);
+            auto &arenas = stage_arenas[rk_flag];
+            advance.AdvanceSlab(tau, *arenas[0], *arenas[1], *arenas[2],
+                                rk_flag, ieta_begin, ieta_end);
+        }
+    }
+
+    for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
+        rotate_arenas(rk_flag, arena_prev, arena_current, arena_future);
+    }
+}
+
 // Cornelius freeze out  (C. Shen, 11/2014)
 int Evolve::FindFreezeOutSurface_Cornelius(double tau,
                                            SCGrid &arena_current,
@@ -255,7 +322,8 @@ int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
     const int ny = arena_current.nY();
 
     std::stringstream strs_name;
-    strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
+    strs_name << DATA.output_directory << "surface_eps_"
+              << std::setprecision(4) << epsFO*hbarc
               << "_" << thread_id << ".dat";
     std::ofstream s_file;
     std::ios_base::openmode modes;
@@ -991,10 +1059,12 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
 
     std::stringstream strs_name;
     if (DATA.boost_invariant == 0) {
-        strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
+        strs_name << DATA.output_directory << "surface_eps_"
+                  << std::setprecision(4) << epsFO*hbarc
                   << "_" << thread_id << ".dat";
     } else {
-        strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
+        strs_name << DATA.output_directory << "surface_eps_"
+                  << std::setprecision(4) << epsFO*hbarc
                   << ".dat";
     }
     std::ofstream s_file;
@@ -1204,7 +1274,8 @@ int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
         double epsFO = epsFO_list[i_freezesurf]/hbarc;
 
         std::stringstream strs_name;
-        strs_name << "surface_eps_" << std::setprecision(4) << epsFO*hbarc
+        strs_name << DATA.output_directory << "surface_eps_"
+                  << std::setprecision(4) << epsFO*hbarc
                   << ".dat";
 
         std::ofstream s_file;
@@ -3,6 +3,7 @@
 #define SRC_EVOLVE_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 #include "util.h"
 #include "data.h"
@@ -39,15 +40,40 @@ class Evolve {
     int n_freeze_surf;
     std::vector<double> epsFO_list;
 
+    //! the copy of the previous freeze-out step, kept between events
+    SCGrid arena_freezeout;
+
     typedef std::unique_ptr<SCGrid, void(*)(SCGrid*)> GridPointer;
 
  public:
     Evolve(const EOS &eos, const InitData &DATA_in,
            std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
+
+    //! sets the hydro source terms of the next event, so that the helpers
+    //! and their tables can be reused for several events
+    void set_hydro_source_terms(
+            std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
     int EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                  SCGrid &arena_future, HydroinfoMUSIC &hydro_info_ptr);
 
     void AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future);
+    void AdvanceRK_blocked(double tau, GridPointer &arena_prev,
+                           GridPointer &arena_current,
+                           GridPointer &arena_future);
+
+    //! rotation of the grids after the Runge-Kutta stage rk_flag
+    template <class Pointer>
+    static void rotate_arenas(const int rk_flag, Pointer &arena_prev,
+                              Pointer &arena_current, Pointer &arena_future) {
+        if (rk_flag == 0) {
+            auto temp     = std::move(arena_prev);
+            arena_prev    = std::move(arena_current);
+            arena_current = std::move(arena_future);
+            arena_future  = std::move(temp);
+        } else {
+            std::swap(arena_current, arena_future);
+        }
+    }
 
     int FreezeOut_equal_tau_Surface(double tau, SCGrid &arena_current);
     void FreezeOut_equal_tau_Surface_XY(double tau,
@@ -83,3 +83,43 @@ TEST_CASE("check dimension"){
     CHECK(grid.nEta() == 3);
 }
 
+
+TEST_CASE("check the allocation of the grid") {
+    SCGrid grid(4, 3, 2);
+    for (int i = 0; i < grid.size(); i++) {
+        CHECK(grid(i).epsilon == 0.);
+        CHECK(grid(i).u[0] == 0.);
+        CHECK(grid(i).Wmunu[13] == 0.);
+    }
+    grid(1, 2, 1).epsilon = 5;
+
+    SCGrid grid_moved = std::move(grid);
+    CHECK(grid.size() == 0);
+    CHECK(grid_moved.nX() == 4);
+    CHECK(grid_moved(1, 2, 1).epsilon == 5);
+
+    SCGrid grid_assigned;
+    grid_assigned = grid_moved;
+    CHECK(grid_assigned.nEta() == 2);
+    CHECK(grid_assigned(1, 2, 1).epsilon == 5);
+    grid_assigned(1, 2, 1).epsilon = 7;
+    CHECK(grid_moved(1, 2, 1).epsilon == 5);
+}
+
+
+TEST_CASE("check the reset of the grid") {
+    SCGrid grid(4, 3, 2);
+    grid(1, 2, 1).epsilon = 5;
+    grid(3, 0, 0).Wmunu[4] = 2;
+    const Cell_small *cells = &grid(0);
+    grid.reset(4, 3, 2);
+    CHECK(&grid(0) == cells);
+    CHECK(grid(1, 2, 1).epsilon == 0.);
+    CHECK(grid(3, 0, 0).Wmunu[4] == 0.);
+
+    grid.reset(2, 5, 3);
+    CHECK(grid.nX() == 2);
+    CHECK(grid.nY() == 5);
+    CHECK(grid.nEta() == 3);
+    CHECK(grid(1, 4, 2).epsilon == 0.);
+}
@@ -2,14 +2,23 @@
 #define _SRC_GRID_H_
 
 #include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "cell.h"
 #include "grid.h"
 
+//! The cells are allocated uninitialized and first touched in parallel with
+//! the same static partition as the cell loops of Advance, so that on NUMA
+//! nodes the pages of a cell end up on the socket of the thread that
+//! updates it
 template<class T>
 class GridT {
  private:
-    std::vector<T> grid;
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "GridT does not call the destructors of its cells");
+    T* grid = nullptr;
 
     int Nx   = 0;
     int Ny   = 0;
@@ -18,6 +27,19 @@ class GridT {
     T& get(int x, int y, int eta) {
         return grid[Nx*(Ny*eta+y)+x];
     }
+
+    //! allocates the cells and value-initializes them in parallel
+    void allocate() {
+        const int n = Nx*Ny*Neta;
+        if (n == 0) return;
+        grid = static_cast<T*>(::operator new(sizeof(T)*n));
+        #pragma omp parallel for collapse(3) schedule(static)
+        for (int eta = 0; eta < Neta; eta++)
+        for (int x   = 0; x   < Nx;   x++  )
+        for (int y   = 0; y   < Ny;   y++  ) {
+            new (&get(x, y, eta)) T();
+        }
+    }
   
  public:
     GridT() = default;
@@ -25,7 +47,34 @@ class GridT {
         Nx   = Nx0  ;
         Ny   = Ny0  ;
         Neta = Neta0;
-        grid.resize(Nx*Ny*Neta);
+        allocate();
+    }
+
+    GridT(const GridT &other) : Nx(other.Nx), Ny(other.Ny), Neta(other.Neta) {
+        allocate();
+        const int n = Nx*Ny*Neta;
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) {
+            grid[i] = other.grid[i];
+        }
+    }
+
+    GridT(GridT &&other) noexcept
+        : grid(other.grid), Nx(other.Nx), Ny(other.Ny), Neta(other.Neta) {
+        other.grid = nullptr;
+        other.Nx = other.Ny = other.Neta = 0;
+    }
+
+    GridT& operator=(GridT other) noexcept {
+        std::swap(grid, other.grid);
+        std::swap(Nx,   other.Nx);
+        std::swap(Ny,   other.Ny);
+        std::swap(Neta, other.Neta);
+        return *this;
+    }
+
+    ~GridT() {
+        ::operator delete(grid);
     }
 
     int nX()   const {return(Nx );  }
@@ -72,8 +121,28 @@ class GridT {
     }
 
     void clear() {
-        grid.clear();
-        grid.shrink_to_fit();
+        ::operator delete(grid);
+        grid = nullptr;
+        Nx = Ny = Neta = 0;
+    }
+
+    //! resizes the grid and value-initializes all the cells. If the size
+    //! does not change, the cells are reused in place
+    void reset(const int Nx0, const int Ny0, const int Neta0) {
+        if (Nx0 != Nx || Ny0 != Ny || Neta0 != Neta) {
+            clear();
+            Nx   = Nx0  ;
+            Ny   = Ny0  ;
+            Neta = Neta0;
+            allocate();
+            return;
+        }
+        #pragma omp parallel for collapse(3) schedule(static)
+        for (int eta = 0; eta < Neta; eta++)
+        for (int x   = 0; x   < Nx;   x++  )
+        for (int y   = 0; y   < Ny;   y++  ) {
+            get(x, y, eta) = T();
+        }
     }
 };
 
@@ -63,7 +63,7 @@ Cell_info::~Cell_info() {
 
 //! This function outputs a header files for JF and Gojko's EM program
 void Cell_info::Output_hydro_information_header() {
-    string fname = "hydro_info_header_h";
+    string fname = DATA.output_directory + "hydro_info_header_h";
 
     // Open output file
     ofstream outfile;
@@ -110,11 +110,13 @@ void Cell_info::Output_hydro_information_header() {
 
 //! This function outputs hydro evolution file
 void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
-    const string out_name_xyeta = "evolution_xyeta.dat";
+    const string out_name_xyeta = DATA.output_directory + "evolution_xyeta.dat";
     const string out_name_W_xyeta =
-                        "evolution_Wmunu_over_epsilon_plus_P_xyeta.dat";
-    const string out_name_bulkpi_xyeta = "evolution_bulk_pressure_xyeta.dat";
-    const string out_name_q_xyeta = "evolution_qmu_xyeta.dat";
+        DATA.output_directory + "evolution_Wmunu_over_epsilon_plus_P_xyeta.dat";
+    const string out_name_bulkpi_xyeta =
+        DATA.output_directory + "evolution_bulk_pressure_xyeta.dat";
+    const string out_name_q_xyeta =
+        DATA.output_directory + "evolution_qmu_xyeta.dat";
     string out_open_mode;
     FILE *out_file_xyeta        = NULL;
     FILE *out_file_W_xyeta      = NULL;
@@ -292,7 +294,8 @@ void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, double tau) {
 
 void Cell_info::OutputEvolution_Knudsen_Reynoldsnumbers(SCGrid &arena,
                                                         double tau) const {
-    const string out_name_xyeta = "evolution_KRnumbers.dat";
+    const string out_name_xyeta = (DATA.output_directory
+                                   + "evolution_KRnumbers.dat");
     FILE *out_file_xyeta        = NULL;
 
     // If it's the first timestep, overwrite the previous file
@@ -367,26 +370,44 @@ void Cell_info::calculate_inverse_Reynolds_numbers(
 }
 
 
-//! This function outputs hydro evolution file into memory for JETSCAPE
+//! This function outputs hydro evolution file into memory for JETSCAPE.
+//! The time slice is allocated first and its cells are then filled in
+//! parallel, every cell has a fixed place in the slice. P, T and s come
+//! from one fused EoS lookup
 void Cell_info::OutputEvolutionDataXYEta_memory(
                 SCGrid &arena, double tau, HydroinfoMUSIC &hydro_info_ptr) {
     const int n_skip_x   = DATA.output_evolution_every_N_x;
     const int n_skip_y   = DATA.output_evolution_every_N_y;
     const int n_skip_eta = DATA.output_evolution_every_N_eta;
-    for (int ix = 0; ix < arena.nX(); ix += n_skip_x) {
-        for (int iy = 0; iy < arena.nY(); iy += n_skip_y) {
-            for (int ieta = 0; ieta < arena.nEta(); ieta += n_skip_eta) {
-                double eta = 0.0;
-                if (DATA.boost_invariant == 0) {
-                    eta = ((static_cast<double>(ieta))*(DATA.delta_eta)
-                            - (DATA.eta_size)/2.0);
-                }
-                double cosh_eta = cosh(eta);
-                double sinh_eta = sinh(eta);
+    const int n_x   = (arena.nX() - 1)/n_skip_x + 1;
+    const int n_y   = (arena.nY() - 1)/n_skip_y + 1;
+    const int n_eta = (arena.nEta() - 1)/n_skip_eta + 1;
+    std::vector<double> cosh_eta_list(n_eta, 1.), sinh_eta_list(n_eta, 0.);
+    if (DATA.boost_invariant == 0) {
+        for (int i_eta = 0; i_eta < n_eta; i_eta++) {
+            const double eta = (
+                static_cast<double>(i_eta*n_skip_eta)*DATA.delta_eta
+                - DATA.eta_size/2.0);
+            cosh_eta_list[i_eta] = cosh(eta);
+            sinh_eta_list[i_eta] = sinh(eta);
+        }
+    }
+    hydro_info_ptr.add_time_slice(tau);
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int i_x = 0; i_x < n_x; i_x++) {
+        for (int i_y = 0; i_y < n_y; i_y++) {
+            for (int i_eta = 0; i_eta < n_eta; i_eta++) {
+                const int ix   = i_x*n_skip_x;
+                const int iy   = i_y*n_skip_y;
+                const int ieta = i_eta*n_skip_eta;
+                const double cosh_eta = cosh_eta_list[i_eta];
+                const double sinh_eta = sinh_eta_list[i_eta];
 
                 double e_local    = arena(ix, iy, ieta).epsilon;  // 1/fm^4
                 double rhob_local = arena(ix, iy, ieta).rhob;     // 1/fm^3
-                double p_local = eos.get_pressure(e_local, rhob_local);
+                double p_local, T_local, s_local;
+                eos.get_thermodynamics(e_local, rhob_local,
+                                       p_local, T_local, s_local);
                 double utau = arena(ix, iy, ieta).u[0];
                 double ux   = arena(ix, iy, ieta).u[1];
                 double uy   = arena(ix, iy, ieta).u[2];
@@ -397,11 +418,9 @@ void Cell_info::OutputEvolutionDataXYEta_memory(
                 double uz = ueta*cosh_eta + utau*sinh_eta;
                 double vz = uz/ut;
 
-                double T_local   = eos.get_temperature(e_local, rhob_local);
-                double s_local   = eos.get_entropy(e_local, rhob_local);
-
-                hydro_info_ptr.dump_ideal_info_to_memory(
-                    tau, eta, e_local, p_local, s_local, T_local, vx, vy, vz);
+                hydro_info_ptr.store_fluid_cell(
+                    i_x, i_y, i_eta, e_local, p_local, s_local, T_local,
+                    vx, vy, vz);
             }
         }
     }
@@ -428,7 +447,8 @@ void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena,
     // Here ueta = tau*ueta, Wieta = tau*Wieta, qeta = tau*qeta
     // Here Wij is reduced variables Wij/(e+P) used in delta f
     // and qi is reduced variables qi/kappa_hat
-    const string out_name_xyeta = "evolution_all_xyeta.dat";
+    const string out_name_xyeta = (DATA.output_directory
+                                   + "evolution_all_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -595,7 +615,8 @@ void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
     // Here ueta = tau*ueta, Wieta = tau*Wieta, qeta = tau*qeta
     // Here Wij is reduced variables Wij/(e+P) used in delta f
     // and qi is reduced variables qi/kappa_hat
-    const string out_name_xyeta = "evolution_for_photon_xyeta.dat";
+    const string out_name_xyeta = (DATA.output_directory
+                                   + "evolution_for_photon_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -745,7 +766,8 @@ double Cell_info::get_maximum_energy_density(SCGrid &arena) {
 //! at a give proper time
 void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
                                        const double tau) {
-    std::string filename = "global_conservation_laws.dat";
+    std::string filename = (DATA.output_directory
+                            + "global_conservation_laws.dat");
     ofstream output_file;
     if (std::abs(tau - DATA.tau0) < 1e-10) {
         output_file.open(filename.c_str(), std::ofstream::out);
@@ -894,7 +916,8 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, double tau) {
     }
 
     ostringstream filename;
-    filename << "Gubser_flow_check_tau_" << tau << ".dat";
+    filename << DATA.output_directory << "Gubser_flow_check_tau_" << tau
+             << ".dat";
     ofstream output_file(filename.str().c_str());
 
     double dx = DATA.delta_x;
@@ -927,7 +950,7 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, double tau) {
 //! This function outputs files to cross check with 1+1D simulation
 void Cell_info::output_1p1D_check_file(SCGrid &arena, double tau) {
     ostringstream filename;
-    filename << "1+1D_check_tau_" << tau << ".dat";
+    filename << DATA.output_directory << "1+1D_check_tau_" << tau << ".dat";
     ofstream output_file(filename.str().c_str());
 
     double unit_convert = 0.19733;  // hbarC
@@ -948,7 +971,8 @@ void Cell_info::output_1p1D_check_file(SCGrid &arena, double tau) {
 
 //! This function outputs energy density and n_b for making movies
 void Cell_info::output_evolution_for_movie(SCGrid &arena, double tau) {
-    const string out_name_xyeta = "evolution_for_movie_xyeta.dat";
+    const string out_name_xyeta = (DATA.output_directory
+                                   + "evolution_for_movie_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -1051,7 +1075,7 @@ void Cell_info::output_evolution_for_movie(SCGrid &arena, double tau) {
 //! This function dumps the energy density and net baryon density
 void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
                                                             string filename) {
-    ofstream output_file(filename.c_str());
+    ofstream output_file((DATA.output_directory + filename).c_str());
     const double unit_convert = 0.19733;  // hbarC [GeV*fm]
     const int n_skip_x   = DATA.output_evolution_every_N_x;
     const int n_skip_y   = DATA.output_evolution_every_N_y;
@@ -1073,7 +1097,8 @@ void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
 void Cell_info::monitor_fluid_cell(SCGrid &arena, int ix, int iy, int ieta,
                                    double tau) {
     ostringstream filename;
-    filename << "monitor_fluid_cell_ix_" << ix << "_iy_" << iy
+    filename << DATA.output_directory
+             << "monitor_fluid_cell_ix_" << ix << "_iy_" << iy
              << "_ieta_" << ieta << ".dat";
     ofstream output_file(filename.str().c_str(),
                          std::ofstream::out | std::ofstream::app);
@@ -1257,7 +1282,8 @@ double Cell_info::get_deltaf_coeff_14moments(double T, double muB,
 void Cell_info::output_average_phase_diagram_trajectory(
                 double tau, double eta_min, double eta_max, SCGrid &arena) {
     ostringstream filename;
-    filename << "averaged_phase_diagram_trajectory_eta_" << eta_min
+    filename << DATA.output_directory
+             << "averaged_phase_diagram_trajectory_eta_" << eta_min
              << "_" << eta_max << ".dat";
     std::fstream of(filename.str().c_str(), std::fstream::app | std::fstream::out);
     if (fabs(tau - DATA.tau0) < 1e-10) {
@@ -1315,7 +1341,7 @@ void Cell_info::output_average_phase_diagram_trajectory(
 void Cell_info::output_momentum_anisotropy_vs_tau(
                 double tau, double eta_min, double eta_max, SCGrid &arena) {
     ostringstream filename;
-    filename << "momentum_anisotropy_eta_" << eta_min
+    filename << DATA.output_directory << "momentum_anisotropy_eta_" << eta_min
              << "_" << eta_max << ".dat";
     std::fstream of;
     if (std::abs(tau - DATA.tau0) < 1e-10) {
@@ -1328,7 +1354,7 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
     }
     
     ostringstream filename1;
-    filename1 << "eccentricities_evo_eta_" << eta_min
+    filename1 << DATA.output_directory << "eccentricities_evo_eta_" << eta_min
               << "_" << eta_max << ".dat";
     std::fstream of1;
     if (std::abs(tau - DATA.tau0) < 1e-10) {
@@ -1,4 +1,7 @@
 // Copyright 2011 @ Bjoern Schenke, Sangyong Jeon, and Charles Gale
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -8,6 +11,7 @@
 #include "./grid.h"
 #include "./init.h"
 #include "./eos.h"
+#include "./initial_condition_file.h"
 
 #ifndef _OPENMP
     #define omp_get_thread_num() 0
@@ -16,10 +20,34 @@
     #include <omp.h>
 #endif
 
+#if defined(_OPENMP) && defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #define MUSIC_THREAD_BINDING
+#endif
+
 using std::vector;
 using std::ifstream;
 using Util::hbarc;
 
+namespace {
+
+//! the columns of the IP-Glasma profiles, Initial_profile 8 uses the
+//! first 7 of them. These are the field names in a binary profile
+const char* const IPGlasma_columns[18] = {
+    "eta", "x", "y", "ed", "utau", "ux", "uy", "ueta",
+    "pi_tautau", "pi_taux", "pi_tauy", "pi_taueta",
+    "pi_xx", "pi_xy", "pi_xeta", "pi_yy", "pi_yeta", "pi_etaeta"};
+
+#ifdef MUSIC_THREAD_BINDING
+//! the affinity of the process before Init::bind_threads, the threads
+//! are shared by all MUSIC instances of the process
+bool threads_are_bound = false;
+cpu_set_t affinity_before_binding;
+#endif
+
+}  // namespace
+
 
 Init::Init(const EOS &eosIn, InitData &DATA_in,
            std::shared_ptr<HydroSourceBase> hydro_source_ptr_in) :
@@ -31,6 +59,8 @@ Init::Init(const EOS &eosIn, InitData &DATA_in,
 void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
                      SCGrid &arena_future) {
     print_num_of_threads();
+    bind_threads();
+    print_thread_binding();
     music_message.info("initArena");
     if (DATA.Initial_profile == 0) {
         music_message << "Using Initial_profile=" << DATA.Initial_profile;
@@ -51,15 +81,14 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
         music_message.flush("info");
     } else if (DATA.Initial_profile == 8) {
         music_message.info(DATA.initName);
-        ifstream profile(DATA.initName.c_str());
-        std::string dummy;
-        int nx, ny, neta;
-        double deta, dx, dy, dummy2;
-        // read the first line with general info
-        profile >> dummy >> dummy >> dummy2
-                >> dummy >> neta >> dummy >> nx >> dummy >> ny
-                >> dummy >> deta >> dummy >> dx >> dummy >> dy;
+        ifstream profile(DATA.initName.c_str(), std::ios::binary);
+        const IPGlasmaHeader header = read_IPGlasma_header(profile);
         profile.close();
+        const int nx = header.nx;
+        const int ny = header.ny;
+        const int neta = header.neta;
+        const double dx = header.dx;
+        const double dy = header.dy;
         music_message << "Using Initial_profile=" << DATA.Initial_profile
                       << ". Overwriting lattice dimensions:";
         DATA.nx = nx;
@@ -74,15 +103,14 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
     } else if (   DATA.Initial_profile == 9 || DATA.Initial_profile == 91
                || DATA.Initial_profile == 92) {
         music_message.info(DATA.initName);
-        ifstream profile(DATA.initName.c_str());
-        std::string dummy;
-        int nx, ny, neta;
-        double deta, dx, dy, dummy2;
-        // read the first line with general info
-        profile >> dummy >> dummy >> dummy2
-                >> dummy >> neta >> dummy >> nx >> dummy >> ny
-                >> dummy >> deta >> dummy >> dx >> dummy >> dy;
+        ifstream profile(DATA.initName.c_str(), std::ios::binary);
+        const IPGlasmaHeader header = read_IPGlasma_header(profile);
         profile.close();
+        const int nx = header.nx;
+        const int ny = header.ny;
+        const int neta = header.neta;
+        const double dx = header.dx;
+        const double dy = header.dy;
         music_message << "Using Initial_profile=" << DATA.Initial_profile
                       << ". Overwriting lattice dimensions:";
         DATA.nx = nx;
@@ -108,8 +136,17 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
                       << ". Overwriting lattice dimensions:";
         music_message.flush("info");
 
+        if (jetscape_fields.e == nullptr || jetscape_fields.u_tau == nullptr
+                || jetscape_fields.u_x == nullptr
+                || jetscape_fields.u_y == nullptr
+                || jetscape_fields.u_eta == nullptr) {
+            music_message << "Init::InitArena: the JETSCAPE initial "
+                          << "condition needs e and u^mu";
+            music_message.flush("error");
+            exit(1);
+        }
         const int nx = static_cast<int>(
-                sqrt(jetscape_initial_energy_density.size()/DATA.neta));
+                sqrt(jetscape_fields.n_cells/DATA.neta));
         const int ny = nx;
         DATA.nx = nx;
         DATA.ny = ny;
@@ -138,10 +175,11 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
         music_message.flush("info");
     }
 
-    // initialize arena
-    arena_prev    = SCGrid(DATA.nx, DATA.ny, DATA.neta);
-    arena_current = SCGrid(DATA.nx, DATA.ny, DATA.neta);
-    arena_future  = SCGrid(DATA.nx, DATA.ny, DATA.neta);
+    // initialize arena, the grids of a previous event are reused if the
+    // size does not change
+    arena_prev.reset   (DATA.nx, DATA.ny, DATA.neta);
+    arena_current.reset(DATA.nx, DATA.ny, DATA.neta);
+    arena_future.reset (DATA.nx, DATA.ny, DATA.neta);
     music_message.info("Grid allocated.");
 
     InitTJb(arena_prev, arena_current);
@@ -163,6 +201,82 @@ void Init::print_num_of_threads() {
     }
 }
 
+//! This function pins the OpenMP threads to the cpus the process may run
+//! on, spread evenly over them, so that the threads stay next to the grid
+//! pages they first touched. It is only done for omp_thread_binding = 1
+//! and not if OMP_PROC_BIND or OMP_PLACES is set, where the binding is
+//! left to the OpenMP runtime, nor for the events of an ensemble, which
+//! share the cpus. unbind_threads restores the affinity of the threads
+void Init::bind_threads() {
+#ifdef MUSIC_THREAD_BINDING
+    if (DATA.omp_thread_binding == 0 || threads_are_bound) return;
+    if (getenv("OMP_PROC_BIND") != nullptr || getenv("OMP_PLACES") != nullptr)
+        return;
+    if (omp_get_level() > 0) return;
+    if (omp_get_max_threads() < 2) return;
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    std::vector<int> cpus;
+    for (int icpu = 0; icpu < CPU_SETSIZE; icpu++) {
+        if (CPU_ISSET(icpu, &allowed)) cpus.push_back(icpu);
+    }
+    if (cpus.size() < 2) return;
+    affinity_before_binding = allowed;
+    threads_are_bound = true;
+    #pragma omp parallel
+    {
+        const int n_threads = omp_get_num_threads();
+        const int icpu = ((static_cast<long>(omp_get_thread_num())*cpus.size())
+                          /n_threads);
+        cpu_set_t thread_set;
+        CPU_ZERO(&thread_set);
+        CPU_SET(cpus[icpu], &thread_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(thread_set),
+                               &thread_set);
+    }
+#endif
+}
+
+
+//! This function gives the OpenMP threads pinned by bind_threads the
+//! affinity of the process before the binding again
+void Init::unbind_threads() {
+#ifdef MUSIC_THREAD_BINDING
+    if (!threads_are_bound) return;
+    #pragma omp parallel
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(affinity_before_binding),
+                               &affinity_before_binding);
+    }
+    threads_are_bound = false;
+#endif
+}
+
+
+//! This function prints the cpu every OpenMP thread runs on
+void Init::print_thread_binding() {
+#ifdef MUSIC_THREAD_BINDING
+    std::vector<int> thread_cpu(omp_get_max_threads(), -1);
+    #pragma omp parallel
+    {
+        thread_cpu[omp_get_thread_num()] = sched_getcpu();
+    }
+    music_message << "OpenMP thread binding (thread:cpu):";
+    for (unsigned int i = 0; i < thread_cpu.size(); i++) {
+        music_message << " " << i << ":" << thread_cpu[i];
+    }
+    music_message.flush("info");
+    if (omp_get_proc_bind() == omp_proc_bind_false
+            && (getenv("OMP_PROC_BIND") != nullptr
+                || getenv("OMP_PLACES") != nullptr)) {
+        music_message.warning(
+            "OpenMP threads are not bound to cpus, the grids may end up "
+            "on a different NUMA node than the threads using them.");
+    }
+#endif
+}
+
+
 //! This is a shell function to initial hydrodynamic fields
 void Init::InitTJb(SCGrid &arena_prev, SCGrid &arena_current) {
     if (DATA.Initial_profile == 0) {
@@ -184,11 +298,8 @@ void Init::InitTJb(SCGrid &arena_prev, SCGrid &arena_current) {
         music_message.info(" ----- information on initial distribution -----");
         music_message << "file name used: " << DATA.initName;
         music_message.flush("info");
-  
-        #pragma omp parallel for
-        for (int ieta = 0; ieta < arena_current.nEta(); ieta++) {
-            initial_IPGlasma_XY(ieta, arena_prev, arena_current);
-        }
+
+        initial_IPGlasma_XY(arena_prev, arena_current);
     } else if (   DATA.Initial_profile == 9 || DATA.Initial_profile == 91
                || DATA.Initial_profile == 92) {
         // read in the profile from file
@@ -197,11 +308,8 @@ void Init::InitTJb(SCGrid &arena_prev, SCGrid &arena_current) {
         music_message.info(" ----- information on initial distribution -----");
         music_message << "file name used: " << DATA.initName;
         music_message.flush("info");
-  
-        #pragma omp parallel for
-        for (int ieta = 0; ieta < arena_current.nEta(); ieta++) {
-            initial_IPGlasma_XY_with_pi(ieta, arena_prev, arena_current);
-        }
+
+        initial_IPGlasma_XY_with_pi(arena_prev, arena_current);
     } else if (DATA.Initial_profile == 11) {
         // read in the transverse profile from file with finite rho_B
         // the initial entropy and net baryon density profile are
@@ -230,11 +338,8 @@ void Init::InitTJb(SCGrid &arena_prev, SCGrid &arena_current) {
         music_message.info(" ----- information on initial distribution -----");
         music_message << "initialized with a JETSCAPE initial condition.";
         music_message.flush("info");
-        #pragma omp parallel for
-        for (int ieta = 0; ieta < arena_current.nEta(); ieta++) {
-            initial_with_jetscape(ieta, arena_prev, arena_current);
-        }
-        clean_up_jetscape_arrays();
+        initial_with_jetscape(arena_prev, arena_current);
+        clean_up_jetscape_fields();
     } else if (DATA.Initial_profile == 101) {
         music_message.info(" ----- information on initial distribution -----");
         music_message << "file name used: " << DATA.initName;
@@ -430,92 +535,181 @@ void Init::initial_1p1D_eta(SCGrid &arena_prev, SCGrid &arena_current) {
     }
 }
 
-void Init::initial_IPGlasma_XY(int ieta, SCGrid &arena_prev,
-                               SCGrid &arena_current) {
-    ifstream profile(DATA.initName.c_str());
-
-    std::string dummy;
-    // read the information line
-    std::getline(profile, dummy);
+//! This function reads the lattice information of an IP-Glasma profile
+//! and leaves the stream at the first cell. The text format starts with the
+//! information line "# tau_in_fm tau0 etamax= neta xmax= nx ymax= ny
+//! deta= deta dx= dx dy= dy". A binary profile is an InitialConditionFile
+//! with the columns of the text format as fields, see IPGlasma_columns
+Init::IPGlasmaHeader Init::read_IPGlasma_header(std::ifstream &profile) {
+    if (!profile.good()) {
+        music_message << "Init::read_IPGlasma_header: "
+                      << "Can not open the initial file: " << DATA.initName;
+        music_message.flush("error");
+        exit(1);
+    }
+    IPGlasmaHeader header;
+    if (InitialConditionFile::is_container(DATA.initName)) {
+        InitialConditionFile file(DATA.initName);
+        header.binary = true;
+        header.neta   = file.get_neta();
+        header.nx     = file.get_nx();
+        header.ny     = file.get_ny();
+        header.deta   = file.get_deta();
+        header.dx     = file.get_dx();
+        header.dy     = file.get_dy();
+    } else {
+        std::string line;
+        std::getline(profile, line);
+        std::stringstream info(line);
+        std::string dummy;
+        double dummy2;
+        info >> dummy >> dummy >> dummy2
+             >> dummy >> header.neta >> dummy >> header.nx >> dummy >> header.ny
+             >> dummy >> header.deta >> dummy >> header.dx >> dummy >> header.dy;
+        header.binary = false;
+    }
+    return(header);
+}
 
-    const int nx = arena_current.nX();
-    const int ny = arena_current.nY();
-    double temp_profile_ed[nx][ny];
-    double temp_profile_utau[nx][ny];
-    double temp_profile_ux[nx][ny];
-    double temp_profile_uy[nx][ny];
 
-    // read the one slice
-    double density, dummy1, dummy2, dummy3;
-    double ux, uy, utau;
-    for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy < ny; iy++) {
-            profile >> dummy1 >> dummy2 >> dummy3
-                    >> density >> utau >> ux >> uy
-                    >> dummy  >> dummy  >> dummy  >> dummy;
-            temp_profile_ed[ix][iy] = density;
-            temp_profile_ux[ix][iy] = ux;
-            temp_profile_uy[ix][iy] = uy;
-            temp_profile_utau[ix][iy] = sqrt(1. + ux*ux + uy*uy);
-            if (ix == 0 && iy == 0) {
-                DATA.x_size = -dummy2*2;
-                DATA.y_size = -dummy3*2;
-                if (omp_get_thread_num() == 0) {
-                    music_message << "eta_size=" << DATA.eta_size
-                                  << ", x_size=" << DATA.x_size
-                                  << ", y_size=" << DATA.y_size;
-                    music_message.flush("info");
+//! This function reads the transverse IP-Glasma profile DATA.initName once
+//! and returns its first n_col columns for the nx*ny cells, with ix running
+//! slower than iy. The text format has one line per cell after the
+//! information line. The binary format is an InitialConditionFile with
+//! neta = 1 and the columns as fields. The transverse size of the grid is
+//! set from the first cell
+std::vector<double> Init::read_IPGlasma_profile(const int nx, const int ny,
+                                                const int n_col) {
+    ifstream profile(DATA.initName.c_str(), std::ios::binary);
+    const IPGlasmaHeader header = read_IPGlasma_header(profile);
+
+    const int n_cells = nx*ny;
+    std::vector<double> columns(static_cast<size_t>(n_cells)*n_col, 0.);
+    if (header.binary) {
+        InitialConditionFile file(DATA.initName);
+        if (file.get_nx() != nx || file.get_ny() != ny
+                || file.get_neta() != 1) {
+            music_message << "Init::read_IPGlasma_profile: "
+                          << DATA.initName << " is not a transverse profile "
+                          << "on a " << nx << " x " << ny << " grid";
+            music_message.flush("error");
+            exit(1);
+        }
+        std::vector<int> i_fields(n_col);
+        for (int icol = 0; icol < n_col; icol++) {
+            i_fields[icol] = file.require_field(IPGlasma_columns[icol]);
+        }
+        #pragma omp parallel for schedule(static)
+        for (int icell = 0; icell < n_cells; icell++) {
+            for (int icol = 0; icol < n_col; icol++) {
+                columns[static_cast<size_t>(icell)*n_col + icol] = (
+                    file.get_value(i_fields[icol], icell/ny, icell%ny, 0));
+            }
+        }
+    } else {
+        std::string line;
+        for (int icell = 0; icell < n_cells; icell++) {
+            std::getline(profile, line);
+            const char *ptr = line.c_str();
+            for (int icol = 0; icol < n_col; icol++) {
+                char *end;
+                const double value = std::strtod(ptr, &end);
+                if (end == ptr) {
+                    music_message << "Init::read_IPGlasma_profile: "
+                                  << DATA.initName << " has fewer than "
+                                  << n_col << " columns for the cell "
+                                  << icell << " of " << n_cells;
+                    music_message.flush("error");
+                    exit(1);
                 }
+                columns[static_cast<size_t>(icell)*n_col + icol] = value;
+                ptr = end;
             }
         }
     }
     profile.close();
 
-    double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
-    double eta_envelop_ed = eta_profile_normalisation(eta);
-    int entropy_flag = DATA.initializeEntropy;
-    for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy< ny; iy++) {
-            double rhob = 0.0;
-            double epsilon = 0.0;
-            if (entropy_flag == 0) {
-                epsilon = (temp_profile_ed[ix][iy]*eta_envelop_ed
-                           *DATA.sFactor/hbarc);  // 1/fm^4
-            } else {
-                double local_sd = (temp_profile_ed[ix][iy]*DATA.sFactor
-                                   *eta_envelop_ed);
-                epsilon = eos.get_s2e(local_sd, rhob);
-            }
-            if (epsilon < 0.00000000001)
-                epsilon = 0.00000000001;
+    DATA.x_size = -columns[1]*2;
+    DATA.y_size = -columns[2]*2;
+    music_message << "eta_size=" << DATA.eta_size
+                  << ", x_size=" << DATA.x_size
+                  << ", y_size=" << DATA.y_size;
+    music_message.flush("info");
+    return(columns);
+}
 
-            arena_current(ix, iy, ieta).epsilon = epsilon;
-            arena_current(ix, iy, ieta).rhob = rhob;
 
-            arena_current(ix, iy, ieta).u[0] = temp_profile_utau[ix][iy];
-            arena_current(ix, iy, ieta).u[1] = temp_profile_ux[ix][iy];
-            arena_current(ix, iy, ieta).u[2] = temp_profile_uy[ix][iy];
-            arena_current(ix, iy, ieta).u[3] = 0.0;
+//! This function initializes the grid with the IP-Glasma energy density
+//! and transverse flow. The transverse profile is read once and
+//! broadcast to all the eta slices with the longitudinal envelope
+void Init::initial_IPGlasma_XY(SCGrid &arena_prev, SCGrid &arena_current) {
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
 
-            arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
+    // eta, x, y, e, u^tau, u^x, u^y, the rest of the line is not used
+    const int n_col = 7;
+    const std::vector<double> profile = read_IPGlasma_profile(nx, ny, n_col);
+
+    std::vector<double> eta_envelop_ed(neta);
+    for (int ieta = 0; ieta < neta; ieta++) {
+        const double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
+        eta_envelop_ed[ieta] = eta_profile_normalisation(eta);
+    }
+
+    const int entropy_flag = DATA.initializeEntropy;
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ix   = 0; ix   < nx;   ix++  )
+    for (int iy   = 0; iy   < ny;   iy++  ) {
+        const double *cell_profile = &profile[(ix*ny + iy)*n_col];
+        const double ed = cell_profile[3];
+        const double ux = cell_profile[5];
+        const double uy = cell_profile[6];
+        double rhob = 0.0;
+        double epsilon = 0.0;
+        if (entropy_flag == 0) {
+            epsilon = (ed*eta_envelop_ed[ieta]
+                       *DATA.sFactor/hbarc);  // 1/fm^4
+        } else {
+            double local_sd = (ed*DATA.sFactor*eta_envelop_ed[ieta]);
+            epsilon = eos.get_s2e(local_sd, rhob);
         }
+        if (epsilon < 0.00000000001)
+            epsilon = 0.00000000001;
+
+        arena_current(ix, iy, ieta).epsilon = epsilon;
+        arena_current(ix, iy, ieta).rhob = rhob;
+
+        arena_current(ix, iy, ieta).u[0] = sqrt(1. + ux*ux + uy*uy);
+        arena_current(ix, iy, ieta).u[1] = ux;
+        arena_current(ix, iy, ieta).u[2] = uy;
+        arena_current(ix, iy, ieta).u[3] = 0.0;
+
+        arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
     }
 }
 
-void Init::initial_IPGlasma_XY_with_pi(int ieta, SCGrid &arena_prev,
+
+//! This function initializes the grid with the IP-Glasma energy density,
+//! flow and shear stress tensor. The transverse profile is read and
+//! converted once, then broadcast to all the eta slices with the
+//! longitudinal envelope
+void Init::initial_IPGlasma_XY_with_pi(SCGrid &arena_prev,
                                        SCGrid &arena_current) {
     // Initial_profile == 9 : full T^\mu\nu
     // Initial_profile == 91: e and u^\mu
     // Initial_profile == 92: e only
     double tau0 = DATA.tau0;
-    ifstream profile(DATA.initName.c_str());
 
-    std::string dummy;
-    // read the information line
-    std::getline(profile, dummy);
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
+
+    // see IPGlasma_columns
+    const int n_col = 18;
+    const std::vector<double> profile = read_IPGlasma_profile(nx, ny, n_col);
 
-    const int nx = arena_current.nX();
-    const int ny = arena_current.nY();
     std::vector<double> temp_profile_ed(nx*ny, 0.0);
     std::vector<double> temp_profile_utau(nx*ny, 0.0);
     std::vector<double> temp_profile_ux(nx*ny, 0.0);
@@ -532,200 +726,244 @@ void Init::initial_IPGlasma_XY_with_pi(int ieta, SCGrid &arena_prev,
     std::vector<double> temp_profile_piyeta(nx*ny, 0.0);
     std::vector<double> temp_profile_pietaeta(nx*ny, 0.0);
 
-    // read the one slice
-    double density, dummy1, dummy2, dummy3;
-    double ux, uy, utau, ueta;
-    double pitautau, pitaux, pitauy, pitaueta;
-    double pixx, pixy, pixeta, piyy, piyeta, pietaeta;
-    for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy < ny; iy++) {
-            int idx = iy + ix*ny;
-            std::getline(profile, dummy);
-            std::stringstream ss(dummy);
-            ss >> dummy1 >> dummy2 >> dummy3
-               >> density >> utau >> ux >> uy >> ueta
-               >> pitautau >> pitaux >> pitauy >> pitaueta
-               >> pixx >> pixy >> pixeta >> piyy >> piyeta >> pietaeta;
-            temp_profile_ed    [idx] = density;
-            temp_profile_ux    [idx] = ux;
-            temp_profile_uy    [idx] = uy;
-            temp_profile_ueta  [idx] = ueta*tau0;
-            temp_profile_utau  [idx] = sqrt(1. + ux*ux + uy*uy + ueta*ueta);
-            temp_profile_pixx  [idx] = pixx*DATA.sFactor;
-            temp_profile_pixy  [idx] = pixy*DATA.sFactor;
-            temp_profile_pixeta[idx] = pixeta*tau0*DATA.sFactor;
-            temp_profile_piyy  [idx] = piyy*DATA.sFactor;
-            temp_profile_piyeta[idx] = piyeta*tau0*DATA.sFactor;
-
-            utau = temp_profile_utau[idx];
-            ueta = ueta*tau0;
-            temp_profile_pietaeta[idx] = (
-                (2.*(  ux*uy*temp_profile_pixy[idx]
-                     + ux*ueta*temp_profile_pixeta[idx]
-                     + uy*ueta*temp_profile_piyeta[idx])
-                 - (utau*utau - ux*ux)*temp_profile_pixx[idx]
-                 - (utau*utau - uy*uy)*temp_profile_piyy[idx])
-                /(utau*utau - ueta*ueta));
-            temp_profile_pitaux  [idx] = (1./utau
-                *(  temp_profile_pixx[idx]*ux
-                  + temp_profile_pixy[idx]*uy
-                  + temp_profile_pixeta[idx]*ueta));
-            temp_profile_pitauy  [idx] = (1./utau
-                *(  temp_profile_pixy[idx]*ux
-                  + temp_profile_piyy[idx]*uy
-                  + temp_profile_piyeta[idx]*ueta));
-            temp_profile_pitaueta[idx] = (1./utau
-                *(  temp_profile_pixeta[idx]*ux
-                  + temp_profile_piyeta[idx]*uy
-                  + temp_profile_pietaeta[idx]*ueta));
-            temp_profile_pitautau[idx] = (1./utau
-                *(  temp_profile_pitaux[idx]*ux
-                  + temp_profile_pitauy[idx]*uy
-                  + temp_profile_pitaueta[idx]*ueta));
-            if (ix == 0 && iy == 0) {
-                DATA.x_size = -dummy2*2;
-                DATA.y_size = -dummy3*2;
-                if (omp_get_thread_num() == 0) {
-                    music_message << "eta_size=" << DATA.eta_size
-                                  << ", x_size=" << DATA.x_size
-                                  << ", y_size=" << DATA.y_size;
-                    music_message.flush("info");
-                }
-            }
-        }
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < nx*ny; idx++) {
+        const double *cell_profile = &profile[idx*n_col];
+        const double density = cell_profile[3];
+        const double ux      = cell_profile[5];
+        const double uy      = cell_profile[6];
+        double       ueta    = cell_profile[7];
+        const double pixx    = cell_profile[12];
+        const double pixy    = cell_profile[13];
+        const double pixeta  = cell_profile[14];
+        const double piyy    = cell_profile[15];
+        const double piyeta  = cell_profile[16];
+
+        temp_profile_ed    [idx] = density;
+        temp_profile_ux    [idx] = ux;
+        temp_profile_uy    [idx] = uy;
+        temp_profile_ueta  [idx] = ueta*tau0;
+        temp_profile_utau  [idx] = sqrt(1. + ux*ux + uy*uy + ueta*ueta);
+        temp_profile_pixx  [idx] = pixx*DATA.sFactor;
+        temp_profile_pixy  [idx] = pixy*DATA.sFactor;
+        temp_profile_pixeta[idx] = pixeta*tau0*DATA.sFactor;
+        temp_profile_piyy  [idx] = piyy*DATA.sFactor;
+        temp_profile_piyeta[idx] = piyeta*tau0*DATA.sFactor;
+
+        const double utau = temp_profile_utau[idx];
+        ueta = ueta*tau0;
+        temp_profile_pietaeta[idx] = (
+            (2.*(  ux*uy*temp_profile_pixy[idx]
+                 + ux*ueta*temp_profile_pixeta[idx]
+                 + uy*ueta*temp_profile_piyeta[idx])
+             - (utau*utau - ux*ux)*temp_profile_pixx[idx]
+             - (utau*utau - uy*uy)*temp_profile_piyy[idx])
+            /(utau*utau - ueta*ueta));
+        temp_profile_pitaux  [idx] = (1./utau
+            *(  temp_profile_pixx[idx]*ux
+              + temp_profile_pixy[idx]*uy
+              + temp_profile_pixeta[idx]*ueta));
+        temp_profile_pitauy  [idx] = (1./utau
+            *(  temp_profile_pixy[idx]*ux
+              + temp_profile_piyy[idx]*uy
+              + temp_profile_piyeta[idx]*ueta));
+        temp_profile_pitaueta[idx] = (1./utau
+            *(  temp_profile_pixeta[idx]*ux
+              + temp_profile_piyeta[idx]*uy
+              + temp_profile_pietaeta[idx]*ueta));
+        temp_profile_pitautau[idx] = (1./utau
+            *(  temp_profile_pitaux[idx]*ux
+              + temp_profile_pitauy[idx]*uy
+              + temp_profile_pitaueta[idx]*ueta));
     }
-    profile.close();
 
-    double eta = (DATA.delta_eta)*(ieta) - (DATA.eta_size)/2.0;
-    double eta_envelop_ed = eta_profile_normalisation(eta);
-    int entropy_flag = DATA.initializeEntropy;
-    for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy< ny; iy++) {
-            int idx = iy + ix*ny;
-            double rhob = 0.0;
-            double epsilon = 0.0;
-            if (entropy_flag == 0) {
-                epsilon = (temp_profile_ed[idx]*eta_envelop_ed
-                           *DATA.sFactor/hbarc);  // 1/fm^4
-            } else {
-                double local_sd = (temp_profile_ed[idx]*DATA.sFactor
-                                   *eta_envelop_ed);
-                epsilon = eos.get_s2e(local_sd, rhob);
-            }
-            if (epsilon < 0.00000000001)
-                epsilon = 0.00000000001;
+    std::vector<double> eta_envelop_ed(neta);
+    for (int ieta = 0; ieta < neta; ieta++) {
+        const double eta = (DATA.delta_eta)*(ieta) - (DATA.eta_size)/2.0;
+        eta_envelop_ed[ieta] = eta_profile_normalisation(eta);
+    }
 
-            arena_current(ix, iy, ieta).epsilon = epsilon;
-            arena_current(ix, iy, ieta).rhob = rhob;
+    const int entropy_flag = DATA.initializeEntropy;
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ix   = 0; ix   < nx;   ix++  )
+    for (int iy   = 0; iy   < ny;   iy++  ) {
+        int idx = iy + ix*ny;
+        double rhob = 0.0;
+        double epsilon = 0.0;
+        if (entropy_flag == 0) {
+            epsilon = (temp_profile_ed[idx]*eta_envelop_ed[ieta]
+                       *DATA.sFactor/hbarc);  // 1/fm^4
+        } else {
+            double local_sd = (temp_profile_ed[idx]*DATA.sFactor
+                               *eta_envelop_ed[ieta]);
+            epsilon = eos.get_s2e(local_sd, rhob);
+        }
+        if (epsilon < 0.00000000001)
+            epsilon = 0.00000000001;
+
+        arena_current(ix, iy, ieta).epsilon = epsilon;
+        arena_current(ix, iy, ieta).rhob = rhob;
+
+        if (DATA.Initial_profile == 9 || DATA.Initial_profile == 91) {
+            arena_current(ix, iy, ieta).u[0] = temp_profile_utau[idx];
+            arena_current(ix, iy, ieta).u[1] = temp_profile_ux[idx];
+            arena_current(ix, iy, ieta).u[2] = temp_profile_uy[idx];
+            arena_current(ix, iy, ieta).u[3] = temp_profile_ueta[idx];
+        } else {
+            arena_current(ix, iy, ieta).u[0] = 1.0;
+            arena_current(ix, iy, ieta).u[1] = 0.0;
+            arena_current(ix, iy, ieta).u[2] = 0.0;
+            arena_current(ix, iy, ieta).u[3] = 0.0;
+        }
 
-            if (DATA.Initial_profile == 9 || DATA.Initial_profile == 91) {
-                arena_current(ix, iy, ieta).u[0] = temp_profile_utau[idx];
-                arena_current(ix, iy, ieta).u[1] = temp_profile_ux[idx];
-                arena_current(ix, iy, ieta).u[2] = temp_profile_uy[idx];
-                arena_current(ix, iy, ieta).u[3] = temp_profile_ueta[idx];
-            } else {
-                arena_current(ix, iy, ieta).u[0] = 1.0;
-                arena_current(ix, iy, ieta).u[1] = 0.0;
-                arena_current(ix, iy, ieta).u[2] = 0.0;
-                arena_current(ix, iy, ieta).u[3] = 0.0;
-            }
-            
-            if (DATA.Initial_profile == 9) {
-                double pressure = eos.get_pressure(epsilon, rhob);
-                arena_current(ix, iy, ieta).pi_b = epsilon/3. - pressure;
-
-                arena_current(ix, iy, ieta).Wmunu[0] = temp_profile_pitautau[idx];
-                arena_current(ix, iy, ieta).Wmunu[1] = temp_profile_pitaux[idx];
-                arena_current(ix, iy, ieta).Wmunu[2] = temp_profile_pitauy[idx];
-                arena_current(ix, iy, ieta).Wmunu[3] = temp_profile_pitaueta[idx];
-                arena_current(ix, iy, ieta).Wmunu[4] = temp_profile_pixx[idx];
-                arena_current(ix, iy, ieta).Wmunu[5] = temp_profile_pixy[idx];
-                arena_current(ix, iy, ieta).Wmunu[6] = temp_profile_pixeta[idx];
-                arena_current(ix, iy, ieta).Wmunu[7] = temp_profile_piyy[idx];
-                arena_current(ix, iy, ieta).Wmunu[8] = temp_profile_piyeta[idx];
-                arena_current(ix, iy, ieta).Wmunu[9] = temp_profile_pietaeta[idx];
-            }
+        if (DATA.Initial_profile == 9) {
+            double pressure = eos.get_pressure(epsilon, rhob);
+            arena_current(ix, iy, ieta).pi_b = epsilon/3. - pressure;
+
+            arena_current(ix, iy, ieta).Wmunu[0] = temp_profile_pitautau[idx];
+            arena_current(ix, iy, ieta).Wmunu[1] = temp_profile_pitaux[idx];
+            arena_current(ix, iy, ieta).Wmunu[2] = temp_profile_pitauy[idx];
+            arena_current(ix, iy, ieta).Wmunu[3] = temp_profile_pitaueta[idx];
+            arena_current(ix, iy, ieta).Wmunu[4] = temp_profile_pixx[idx];
+            arena_current(ix, iy, ieta).Wmunu[5] = temp_profile_pixy[idx];
+            arena_current(ix, iy, ieta).Wmunu[6] = temp_profile_pixeta[idx];
+            arena_current(ix, iy, ieta).Wmunu[7] = temp_profile_piyy[idx];
+            arena_current(ix, iy, ieta).Wmunu[8] = temp_profile_piyeta[idx];
+            arena_current(ix, iy, ieta).Wmunu[9] = temp_profile_pietaeta[idx];
+        }
 
-            arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
+        arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
+    }
+}
+
+//! This function reads the transverse thickness profiles TA, TB, rhob_TA
+//! and rhob_TB for Initial_profile 11 from the text files, one value per
+//! cell with ix running slower than iy. The rhob profiles are zero if
+//! turn_on_rhob is off
+std::vector<std::vector<double>> Init::read_MCGlb_profiles(const int nx,
+                                                           const int ny) {
+    const std::string file_names[4] = {DATA.initName_TA, DATA.initName_TB,
+                                       DATA.initName_rhob_TA,
+                                       DATA.initName_rhob_TB};
+    std::vector<std::vector<double>> profiles(4,
+                                              std::vector<double>(nx*ny, 0.));
+    const int n_profiles = (DATA.turn_on_rhob == 1) ? 4 : 2;
+    for (int i = 0; i < n_profiles; i++) {
+        ifstream profile(file_names[i].c_str());
+        if (!profile.good()) {
+            music_message << "Init::read_MCGlb_profiles: "
+                          << "Can not open the initial file: "
+                          << file_names[i];
+            music_message.flush("error");
+            exit(1);
         }
+        for (int idx = 0; idx < nx*ny; idx++) {
+            profile >> profiles[i][idx];
+        }
+        profile.close();
     }
+    return(profiles);
 }
 
-void Init::initial_MCGlb_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
-    // first load in the transverse profile
-    ifstream profile_TA(DATA.initName_TA.c_str());
-    ifstream profile_TB(DATA.initName_TB.c_str());
-    ifstream profile_rhob_TA(DATA.initName_rhob_TA.c_str());
-    ifstream profile_rhob_TB(DATA.initName_rhob_TB.c_str());
 
+//! This function initializes the grid with the thickness functions of the
+//! MC-Glauber model. DATA.initName_TA is either the text profile of TA,
+//! with TB, rhob_TA and rhob_TB in their own files, or an
+//! InitialConditionFile with all four as fields. The longitudinal
+//! envelopes are computed once per eta slice
+void Init::initial_MCGlb_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
     const int nx = arena_current.nX();
     const int ny = arena_current.nY();
-    double temp_profile_TA[nx][ny];
-    double temp_profile_TB[nx][ny];
-    double temp_profile_rhob_TA[nx][ny];
-    double temp_profile_rhob_TB[nx][ny];
-    for (int i = 0; i < nx; i++) {
-        for (int j = 0; j < ny; j++) {
-            profile_TA >> temp_profile_TA[i][j];
-            profile_TB >> temp_profile_TB[i][j];
-            profile_rhob_TA >> temp_profile_rhob_TA[i][j];
-            profile_rhob_TB >> temp_profile_rhob_TB[i][j];
+
+    // first load in the transverse profile
+    std::vector<std::vector<double>> profiles;
+    if (InitialConditionFile::is_container(DATA.initName_TA)) {
+        InitialConditionFile file(DATA.initName_TA);
+        if (file.get_nx() != nx || file.get_ny() != ny
+                || file.get_neta() != 1) {
+            music_message << "Init::initial_MCGlb_with_rhob: "
+                          << DATA.initName_TA << " is not a transverse "
+                          << "profile on a " << nx << " x " << ny << " grid";
+            music_message.flush("error");
+            exit(1);
         }
+        const int n_profiles = (DATA.turn_on_rhob == 1) ? 4 : 2;
+        const std::string field_names[4] = {"TA", "TB", "rhob_TA", "rhob_TB"};
+        int i_fields[4];
+        for (int i = 0; i < n_profiles; i++) {
+            i_fields[i] = file.require_field(field_names[i]);
+        }
+        profiles.assign(4, std::vector<double>(nx*ny, 0.));
+        #pragma omp parallel for schedule(static)
+        for (int idx = 0; idx < nx*ny; idx++) {
+            for (int i = 0; i < n_profiles; i++) {
+                profiles[i][idx] = file.get_value(i_fields[i], idx/ny,
+                                                  idx%ny, 0);
+            }
+        }
+    } else {
+        profiles = read_MCGlb_profiles(nx, ny);
     }
-    profile_TA.close();
-    profile_TB.close();
-    profile_rhob_TA.close();
-    profile_rhob_TB.close();
+    const std::vector<double> &temp_profile_TA      = profiles[0];
+    const std::vector<double> &temp_profile_TB      = profiles[1];
+    const std::vector<double> &temp_profile_rhob_TA = profiles[2];
+    const std::vector<double> &temp_profile_rhob_TB = profiles[3];
 
-    int entropy_flag = DATA.initializeEntropy;
-
-    #pragma omp parallel for
-    for (int ieta = 0; ieta < arena_current.nEta(); ieta++) {
-        double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
-        double eta_envelop_left  = eta_profile_left_factor(eta);
-        double eta_envelop_right = eta_profile_right_factor(eta);
-        double eta_rhob_left     = eta_rhob_left_factor(eta);
-        double eta_rhob_right    = eta_rhob_right_factor(eta);
+    // the longitudinal envelopes of the projectile and the target
+    const int neta = arena_current.nEta();
+    std::vector<double> eta_envelop_left(neta), eta_envelop_right(neta);
+    std::vector<double> eta_rhob_left(neta), eta_rhob_right(neta);
+    for (int ieta = 0; ieta < neta; ieta++) {
+        const double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
+        eta_envelop_left[ieta]  = eta_profile_left_factor(eta);
+        eta_envelop_right[ieta] = eta_profile_right_factor(eta);
+        eta_rhob_left[ieta]     = eta_rhob_left_factor(eta);
+        eta_rhob_right[ieta]    = eta_rhob_right_factor(eta);
+    }
 
-        for (int ix = 0; ix < nx; ix++) {
-            for (int iy = 0; iy< ny; iy++) {
-                double rhob = 0.0;
-                double epsilon = 0.0;
-                if (DATA.turn_on_rhob == 1) {
-                    rhob = (
-                        (temp_profile_rhob_TA[ix][iy]*eta_rhob_left
-                         + temp_profile_rhob_TB[ix][iy]*eta_rhob_right));
-                } else {
-                    rhob = 0.0;
-                }
-                if (entropy_flag == 0) {
-                    epsilon = (
-                        (temp_profile_TA[ix][iy]*eta_envelop_left
-                         + temp_profile_TB[ix][iy]*eta_envelop_right)
-                        *DATA.sFactor/hbarc);   // 1/fm^4
-                } else {
-                    double local_sd = (
-                        (temp_profile_TA[ix][iy]*eta_envelop_left
-                         + temp_profile_TB[ix][iy]*eta_envelop_right)
-                        *DATA.sFactor);         // 1/fm^3
-                    epsilon = eos.get_s2e(local_sd, rhob);
-                }
-                epsilon = std::max(1e-12, epsilon);
+    const int entropy_flag = DATA.initializeEntropy;
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ix   = 0; ix   < nx;   ix++  )
+    for (int iy   = 0; iy   < ny;   iy++  ) {
+        const int idx = ix*ny + iy;
+        double rhob = 0.0;
+        double epsilon = 0.0;
+        if (DATA.turn_on_rhob == 1) {
+            rhob = (
+                (temp_profile_rhob_TA[idx]*eta_rhob_left[ieta]
+                 + temp_profile_rhob_TB[idx]*eta_rhob_right[ieta]));
+        } else {
+            rhob = 0.0;
+        }
+        if (entropy_flag == 0) {
+            epsilon = (
+                (temp_profile_TA[idx]*eta_envelop_left[ieta]
+                 + temp_profile_TB[idx]*eta_envelop_right[ieta])
+                *DATA.sFactor/hbarc);   // 1/fm^4
+        } else {
+            double local_sd = (
+                (temp_profile_TA[idx]*eta_envelop_left[ieta]
+                 + temp_profile_TB[idx]*eta_envelop_right[ieta])
+                *DATA.sFactor);         // 1/fm^3
+            epsilon = eos.get_s2e(local_sd, rhob);
+        }
+        epsilon = std::max(1e-12, epsilon);
 
-                arena_current(ix, iy, ieta).epsilon = epsilon;
-                arena_current(ix, iy, ieta).rhob = rhob;
+        arena_current(ix, iy, ieta).epsilon = epsilon;
+        arena_current(ix, iy, ieta).rhob = rhob;
 
-                arena_current(ix, iy, ieta).u[0] = 1.0;
-                arena_current(ix, iy, ieta).u[1] = 0.0;
-                arena_current(ix, iy, ieta).u[2] = 0.0;
-                arena_current(ix, iy, ieta).u[3] = 0.0;
+        arena_current(ix, iy, ieta).u[0] = 1.0;
+        arena_current(ix, iy, ieta).u[1] = 0.0;
+        arena_current(ix, iy, ieta).u[2] = 0.0;
+        arena_current(ix, iy, ieta).u[3] = 0.0;
 
-                arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
-            }
-        }
+        arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
     }
 }
 
+
 void Init::initial_MCGlbLEXUS_with_rhob_XY(int ieta, SCGrid &arena_prev,
                                            SCGrid &arena_current) {
     const int nx = arena_current.nX();
@@ -750,10 +988,14 @@ void Init::initial_MCGlbLEXUS_with_rhob_XY(int ieta, SCGrid &arena_prev,
 }
 
 
-void Init::initial_UMN_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
-    // first load in the transverse profile
+//! This function reads the 3D profile of Initial_profile 101 from the text
+//! file DATA.initName. After an information line, every cell has a line
+//! with the columns x, y, eta, rhob, and e, with ieta running slowest and
+//! iy fastest. Returns rhob and e
+std::vector<std::vector<double>> Init::read_UMN_profile(const int nx,
+                                                        const int ny,
+                                                        const int neta) {
     ifstream profile(DATA.initName.c_str());
-
     if (!profile) {
         music_message << "Can not open file: " << DATA.initName;
         music_message.flush("error");
@@ -762,36 +1004,167 @@ void Init::initial_UMN_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
     std::string dummy_s;
     std::getline(profile, dummy_s);
 
+    const size_t n_cells = static_cast<size_t>(nx)*ny*neta;
+    std::vector<std::vector<double>> profiles(2,
+                                              std::vector<double>(n_cells));
+    std::string line;
+    for (size_t idx = 0; idx < n_cells; idx++) {
+        std::getline(profile, line);
+        const char *ptr = line.c_str();
+        double values[5];
+        for (int icol = 0; icol < 5; icol++) {
+            char *end;
+            values[icol] = std::strtod(ptr, &end);
+            if (end == ptr) {
+                music_message << "Init::read_UMN_profile: "
+                              << DATA.initName << " has fewer than 5 "
+                              << "columns for the cell " << idx << " of "
+                              << n_cells;
+                music_message.flush("error");
+                exit(1);
+            }
+            ptr = end;
+        }
+        profiles[0][idx] = values[3];
+        profiles[1][idx] = values[4];
+    }
+    profile.close();
+    return(profiles);
+}
+
+
+//! This function initializes the grid with the 3D profile of e and rhob in
+//! DATA.initName, a text file or an InitialConditionFile with the fields
+//! rhob and ed. The binary file is read in place
+void Init::initial_UMN_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
     const int nx   = arena_current.nX();
     const int ny   = arena_current.nY();
     const int neta = arena_current.nEta();
 
-    double dummy;
-    double ed_local, rhob_local;
-    for (int ieta = 0; ieta < neta; ieta++) {
-        for (int ix = 0; ix < nx; ix++) {
-            for (int iy = 0; iy< ny; iy++) {
-                profile >> dummy >> dummy >> dummy >> rhob_local >> ed_local;
-                double rhob    = rhob_local;
-                double epsilon = ed_local*DATA.sFactor/hbarc;    // 1/fm^4
+    // first load in the profile
+    std::unique_ptr<InitialConditionFile> file;
+    std::vector<std::vector<double>> profiles;
+    int i_rhob = 0;
+    int i_ed   = 1;
+    if (InitialConditionFile::is_container(DATA.initName)) {
+        file.reset(new InitialConditionFile(DATA.initName));
+        if (file->get_nx() != nx || file->get_ny() != ny
+                || file->get_neta() != neta) {
+            music_message << "Init::initial_UMN_with_rhob: "
+                          << DATA.initName << " is not a profile on a "
+                          << nx << " x " << ny << " x " << neta << " grid";
+            music_message.flush("error");
+            exit(1);
+        }
+        i_rhob = file->require_field("rhob");
+        i_ed   = file->require_field("ed");
+    } else {
+        profiles = read_UMN_profile(nx, ny, neta);
+    }
 
-                if (epsilon < 0.00000000001) {
-                    epsilon = 0.00000000001;
-                }
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ix   = 0; ix   < nx;   ix++  )
+    for (int iy   = 0; iy   < ny;   iy++  ) {
+        double rhob_local, ed_local;
+        if (file) {
+            rhob_local = file->get_value(i_rhob, ix, iy, ieta);
+            ed_local   = file->get_value(i_ed,   ix, iy, ieta);
+        } else {
+            const size_t idx = (static_cast<size_t>(ieta)*nx + ix)*ny + iy;
+            rhob_local = profiles[i_rhob][idx];
+            ed_local   = profiles[i_ed][idx];
+        }
+        double rhob    = rhob_local;
+        double epsilon = ed_local*DATA.sFactor/hbarc;    // 1/fm^4
 
-                arena_current(ix, iy, ieta).epsilon = epsilon;
-                arena_current(ix, iy, ieta).rhob = rhob;
+        if (epsilon < 0.00000000001) {
+            epsilon = 0.00000000001;
+        }
 
-                arena_current(ix, iy, ieta).u[0] = 1.0;
-                arena_current(ix, iy, ieta).u[1] = 0.0;
-                arena_current(ix, iy, ieta).u[2] = 0.0;
-                arena_current(ix, iy, ieta).u[3] = 0.0;
-            
-                arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
+        arena_current(ix, iy, ieta).epsilon = epsilon;
+        arena_current(ix, iy, ieta).rhob = rhob;
+
+        arena_current(ix, iy, ieta).u[0] = 1.0;
+        arena_current(ix, iy, ieta).u[1] = 0.0;
+        arena_current(ix, iy, ieta).u[2] = 0.0;
+        arena_current(ix, iy, ieta).u[3] = 0.0;
+
+        arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
+    }
+}
+
+
+//! This function converts the text initial condition of
+//! DATA.Initial_profile (8, 9, 91, 92, 11 or 101) into an
+//! InitialConditionFile, written next to it with the suffix ".bin".
+//! DATA.initial_condition_binary_precision selects float or double
+void Init::convert_initial_condition() {
+    const int precision = DATA.initial_condition_binary_precision;
+    std::string input_name;
+    int nx, ny, neta;
+    double dx, dy, deta;
+    std::vector<std::string> field_names;
+    std::vector<std::vector<double>> fields;
+    if (   DATA.Initial_profile == 8 || DATA.Initial_profile == 9
+        || DATA.Initial_profile == 91 || DATA.Initial_profile == 92) {
+        input_name = DATA.initName;
+        ifstream profile(input_name.c_str(), std::ios::binary);
+        const IPGlasmaHeader header = read_IPGlasma_header(profile);
+        profile.close();
+        if (header.binary) {
+            music_message << input_name << " is already binary";
+            music_message.flush("error");
+            exit(1);
+        }
+        nx   = header.nx;
+        ny   = header.ny;
+        neta = 1;
+        dx   = header.dx;
+        dy   = header.dy;
+        deta = header.deta;
+        const int n_col = (DATA.Initial_profile == 8) ? 7 : 18;
+        const std::vector<double> columns = read_IPGlasma_profile(nx, ny,
+                                                                  n_col);
+        for (int icol = 0; icol < n_col; icol++) {
+            field_names.push_back(IPGlasma_columns[icol]);
+            std::vector<double> field(nx*ny);
+            for (int icell = 0; icell < nx*ny; icell++) {
+                field[icell] = columns[icell*n_col + icol];
             }
+            fields.push_back(field);
         }
+    } else if (DATA.Initial_profile == 11) {
+        input_name = DATA.initName_TA;
+        nx   = DATA.nx;
+        ny   = DATA.ny;
+        neta = 1;
+        dx   = DATA.delta_x;
+        dy   = DATA.delta_y;
+        deta = DATA.delta_eta;
+        field_names = {"TA", "TB", "rhob_TA", "rhob_TB"};
+        fields = read_MCGlb_profiles(nx, ny);
+    } else if (DATA.Initial_profile == 101) {
+        input_name = DATA.initName;
+        nx   = DATA.nx;
+        ny   = DATA.ny;
+        neta = DATA.neta;
+        dx   = DATA.delta_x;
+        dy   = DATA.delta_y;
+        deta = DATA.delta_eta;
+        field_names = {"rhob", "ed"};
+        fields = read_UMN_profile(nx, ny, neta);
+    } else {
+        music_message << "Initial_profile " << DATA.Initial_profile
+                      << " is not read from a text file, nothing to convert";
+        music_message.flush("error");
+        exit(1);
     }
-    profile.close();
+    const std::string output_name = input_name + ".bin";
+    InitialConditionFile::write(output_name, precision, nx, ny, neta,
+                                dx, dy, deta, field_names, fields);
+    music_message << "converted " << input_name << " to " << output_name;
+    music_message.flush("info");
 }
 
 void Init::initial_AMPT_XY(int ieta, SCGrid &arena_prev,
@@ -838,96 +1211,66 @@ void Init::initial_AMPT_XY(int ieta, SCGrid &arena_prev,
 }
 
 
-void Init::get_jetscape_preequilibrium_vectors(
-        vector<double> e_in,
-        vector<double> u_tau_in, vector<double> u_x_in,
-        vector<double> u_y_in,   vector<double> u_eta_in,
-        vector<double> pi_00_in, vector<double> pi_01_in,
-        vector<double> pi_02_in, vector<double> pi_03_in,
-        vector<double> pi_11_in, vector<double> pi_12_in,
-        vector<double> pi_13_in, vector<double> pi_22_in,
-        vector<double> pi_23_in, vector<double> pi_33_in,
-        vector<double> Bulk_pi_in) {
-    jetscape_initial_energy_density = e_in;
-    jetscape_initial_u_tau          = u_tau_in;
-    jetscape_initial_u_x            = u_x_in;
-    jetscape_initial_u_y            = u_y_in;
-    jetscape_initial_u_eta          = u_eta_in;
-    jetscape_initial_pi_00          = pi_00_in;
-    jetscape_initial_pi_01          = pi_01_in;
-    jetscape_initial_pi_02          = pi_02_in;
-    jetscape_initial_pi_03          = pi_03_in;
-    jetscape_initial_pi_11          = pi_11_in;
-    jetscape_initial_pi_12          = pi_12_in;
-    jetscape_initial_pi_13          = pi_13_in;
-    jetscape_initial_pi_22          = pi_22_in;
-    jetscape_initial_pi_23          = pi_23_in;
-    jetscape_initial_pi_33          = pi_33_in;
-    jetscape_initial_bulk_pi        = Bulk_pi_in;
+//! This function keeps the pointers to the JETSCAPE pre-equilibrium
+//! fields, which are read in place by initial_with_jetscape
+void Init::set_jetscape_preequilibrium_fields(
+        const PreequilibriumFields &fields) {
+    jetscape_fields = fields;
 }
 
 
-void Init::initial_with_jetscape(int ieta, SCGrid &arena_prev,
-                                 SCGrid &arena_current) {
+//! This function initializes the grid with the JETSCAPE pre-equilibrium
+//! fields, reading the buffers of the framework in place
+void Init::initial_with_jetscape(SCGrid &arena_prev, SCGrid &arena_current) {
     const int nx = arena_current.nX();
     const int ny = arena_current.nY();
     const int neta = arena_current.nEta();
-    
-    for (int ix = 0; ix < nx; ix++) {
-        for (int iy = 0; iy< ny; iy++) {
-            const double rhob = 0.0;
-            double epsilon = 0.0;
-            //const int idx = iy + ix*ny + ieta*ny*nx;  // old trento convension
-            const int idx = ieta + iy*neta + ix*ny*neta;  // new trento convension
-            epsilon = (jetscape_initial_energy_density[idx]
-                       *DATA.sFactor/hbarc);  // 1/fm^4
-            if (epsilon < 0.00000000001)
-                epsilon = 0.00000000001;
-
-            arena_current(ix, iy, ieta).epsilon = epsilon;
-            arena_current(ix, iy, ieta).rhob = rhob;
-
-            arena_current(ix, iy, ieta).u[0] = jetscape_initial_u_tau[idx];
-            arena_current(ix, iy, ieta).u[1] = jetscape_initial_u_x[idx];
-            arena_current(ix, iy, ieta).u[2] = jetscape_initial_u_y[idx];
-            arena_current(ix, iy, ieta).u[3] = DATA.tau0*jetscape_initial_u_eta[idx];
-
-            arena_current(ix, iy, ieta).pi_b = jetscape_initial_bulk_pi[idx]/hbarc;
-
-            arena_current(ix, iy, ieta).Wmunu[0] = jetscape_initial_pi_00[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[1] = jetscape_initial_pi_01[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[2] = jetscape_initial_pi_02[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[3] = jetscape_initial_pi_03[idx]/hbarc*DATA.tau0;
-            arena_current(ix, iy, ieta).Wmunu[4] = jetscape_initial_pi_11[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[5] = jetscape_initial_pi_12[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[6] = jetscape_initial_pi_13[idx]/hbarc*DATA.tau0;
-            arena_current(ix, iy, ieta).Wmunu[7] = jetscape_initial_pi_22[idx]/hbarc;
-            arena_current(ix, iy, ieta).Wmunu[8] = jetscape_initial_pi_23[idx]/hbarc*DATA.tau0;
-            arena_current(ix, iy, ieta).Wmunu[9] = jetscape_initial_pi_33[idx]/hbarc*DATA.tau0*DATA.tau0;
-
-            arena_prev(ix, iy, ieta) = arena_current(ix, iy, ieta);
-        }
+    const PreequilibriumFields &fields = jetscape_fields;
+
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int ix   = 0; ix   < nx;   ix++  )
+    for (int iy   = 0; iy   < ny;   iy++  ) {
+        const double rhob = 0.0;
+        double epsilon = 0.0;
+        //const int idx = iy + ix*ny + ieta*ny*nx;  // old trento convension
+        const int idx = ieta + iy*neta + ix*ny*neta;  // new trento convension
+        epsilon = (fields.e[idx]*DATA.sFactor/hbarc);  // 1/fm^4
+        if (epsilon < 0.00000000001)
+            epsilon = 0.00000000001;
+
+        Cell_small &cell = arena_current(ix, iy, ieta);
+        cell.epsilon = epsilon;
+        cell.rhob = rhob;
+
+        cell.u[0] = fields.u_tau[idx];
+        cell.u[1] = fields.u_x[idx];
+        cell.u[2] = fields.u_y[idx];
+        cell.u[3] = DATA.tau0*fields.u_eta[idx];
+
+        // a field that is not given starts at zero
+        auto value = [idx](const double *field) {
+            return(field == nullptr ? 0. : field[idx]);
+        };
+        cell.pi_b = value(fields.bulk_pi)/hbarc;
+
+        cell.Wmunu[0] = value(fields.pi_00)/hbarc;
+        cell.Wmunu[1] = value(fields.pi_01)/hbarc;
+        cell.Wmunu[2] = value(fields.pi_02)/hbarc;
+        cell.Wmunu[3] = value(fields.pi_03)/hbarc*DATA.tau0;
+        cell.Wmunu[4] = value(fields.pi_11)/hbarc;
+        cell.Wmunu[5] = value(fields.pi_12)/hbarc;
+        cell.Wmunu[6] = value(fields.pi_13)/hbarc*DATA.tau0;
+        cell.Wmunu[7] = value(fields.pi_22)/hbarc;
+        cell.Wmunu[8] = value(fields.pi_23)/hbarc*DATA.tau0;
+        cell.Wmunu[9] = value(fields.pi_33)/hbarc*DATA.tau0*DATA.tau0;
+
+        arena_prev(ix, iy, ieta) = cell;
     }
 }
 
-void Init::clean_up_jetscape_arrays() {
-    // clean up
-    jetscape_initial_energy_density.clear();
-    jetscape_initial_u_tau.clear();
-    jetscape_initial_u_x.clear();
-    jetscape_initial_u_y.clear();
-    jetscape_initial_u_eta.clear();
-    jetscape_initial_pi_00.clear();
-    jetscape_initial_pi_01.clear();
-    jetscape_initial_pi_02.clear();
-    jetscape_initial_pi_03.clear();
-    jetscape_initial_pi_11.clear();
-    jetscape_initial_pi_12.clear();
-    jetscape_initial_pi_13.clear();
-    jetscape_initial_pi_22.clear();
-    jetscape_initial_pi_23.clear();
-    jetscape_initial_pi_33.clear();
-    jetscape_initial_bulk_pi.clear();
+void Init::clean_up_jetscape_fields() {
+    jetscape_fields = PreequilibriumFields();
 }
 
 double Init::eta_profile_normalisation(double eta) {
@@ -1048,7 +1391,8 @@ void Init::output_initial_density_profiles(SCGrid &arena) {
     // and net baryon density profile (if turn_on_rhob == 1)
     // for checking purpose
     music_message.info("output initial density profiles into a file... ");
-    std::ofstream of("check_initial_density_profiles.dat");
+    std::ofstream of((DATA.output_directory
+                      + "check_initial_density_profiles.dat").c_str());
     of << "# x(fm)  y(fm)  eta  ed(GeV/fm^3)";
     if (DATA.turn_on_rhob == 1)
         of << "  rhob(1/fm^3)";
@@ -3,6 +3,7 @@
 #define SRC_INIT_H_
 
 #include <stdio.h>
+#include <fstream>
 #include <vector>
 #include <cmath>
 #include <memory>
@@ -21,23 +22,16 @@ class Init {
     std::weak_ptr<HydroSourceBase> hydro_source_terms_ptr;
     pretty_ostream music_message;
         
-    // support for JETSCAPE
-    std::vector<double> jetscape_initial_energy_density;
-    std::vector<double> jetscape_initial_u_tau;
-    std::vector<double> jetscape_initial_u_x;
-    std::vector<double> jetscape_initial_u_y;
-    std::vector<double> jetscape_initial_u_eta;
-    std::vector<double> jetscape_initial_pi_00;
-    std::vector<double> jetscape_initial_pi_01;
-    std::vector<double> jetscape_initial_pi_02;
-    std::vector<double> jetscape_initial_pi_03;
-    std::vector<double> jetscape_initial_pi_11;
-    std::vector<double> jetscape_initial_pi_12;
-    std::vector<double> jetscape_initial_pi_13;
-    std::vector<double> jetscape_initial_pi_22;
-    std::vector<double> jetscape_initial_pi_23;
-    std::vector<double> jetscape_initial_pi_33;
-    std::vector<double> jetscape_initial_bulk_pi;
+    // support for JETSCAPE, the fields are read in place
+    PreequilibriumFields jetscape_fields;
+
+    //! lattice information of an IP-Glasma profile
+    struct IPGlasmaHeader {
+        bool binary;
+        int neta, nx, ny;
+        double deta, dx, dy;
+    };
+    IPGlasmaHeader read_IPGlasma_header(std::ifstream &profile);
 
  public:
     Init(const EOS &eos, InitData &DATA_in,
@@ -47,28 +41,28 @@ class Init {
                    SCGrid &arena_future);
     void InitTJb  (SCGrid &arena_prev, SCGrid &arena_current);
     void print_num_of_threads();
+    void bind_threads();
+    static void unbind_threads();
+    void print_thread_binding();
 
     void initial_Gubser_XY               (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
     void initial_1p1D_eta                (SCGrid &arena_prev, SCGrid &arena_current);
-    void initial_IPGlasma_XY             (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
-    void initial_IPGlasma_XY_with_pi     (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
+    std::vector<double> read_IPGlasma_profile(int nx, int ny, int n_col);
+    std::vector<std::vector<double>> read_MCGlb_profiles(int nx, int ny);
+    std::vector<std::vector<double>> read_UMN_profile(int nx, int ny,
+                                                      int neta);
+    void convert_initial_condition();
+    void initial_IPGlasma_XY             (SCGrid &arena_prev, SCGrid &arena_current);
+    void initial_IPGlasma_XY_with_pi     (SCGrid &arena_prev, SCGrid &arena_current);
     void initial_MCGlbLEXUS_with_rhob_XY (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
     void initial_AMPT_XY                 (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
     void initial_MCGlb_with_rhob         (SCGrid &arena_prev, SCGrid &arena_current);
     void initial_UMN_with_rhob           (SCGrid &arena_prev, SCGrid & arena_current);
-    void initial_with_jetscape           (int ieta, SCGrid &arena_prev, SCGrid &arena_current);
+    void initial_with_jetscape           (SCGrid &arena_prev, SCGrid &arena_current);
 
-    void get_jetscape_preequilibrium_vectors(
-        std::vector<double> e_in,
-        std::vector<double> u_tau_in, std::vector<double> u_x_in,
-        std::vector<double> u_y_in,   std::vector<double> u_eta_in,
-        std::vector<double> pi_00_in, std::vector<double> pi_01_in,
-        std::vector<double> pi_02_in, std::vector<double> pi_03_in,
-        std::vector<double> pi_11_in, std::vector<double> pi_12_in,
-        std::vector<double> pi_13_in, std::vector<double> pi_22_in,
-        std::vector<double> pi_23_in, std::vector<double> pi_33_in,
-        std::vector<double> Bulk_pi_in);
-    void clean_up_jetscape_arrays();
+    void set_jetscape_preequilibrium_fields(
+        const PreequilibriumFields &fields);
+    void clean_up_jetscape_fields();
     
     double eta_profile_normalisation       (double eta);
     double eta_rhob_profile_normalisation  (double eta);
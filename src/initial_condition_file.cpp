@@ -0,0 +1,210 @@
+// Copyright @ Bjoern Schenke, Sangyong Jeon, Charles Gale, and Chun Shen
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "initial_condition_file.h"
+#include "pretty_ostream.h"
+#include "doctest.h"
+
+namespace {
+
+const char container_magic[8] = {'M', 'U', 'S', 'I', 'C', 'I', 'C', '1'};
+const int32_t container_version = 1;
+//! magic, version, precision, nx, ny, neta, n_fields, dx, dy, deta
+const size_t container_fixed_header_size = 8 + 6*sizeof(int32_t)
+                                           + 3*sizeof(double);
+
+}  // namespace
+
+
+InitialConditionFile::InitialConditionFile(const std::string &file_name)
+        : file_name_(file_name) {
+    pretty_ostream music_message;
+    const int fd = open(file_name.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+        music_message << "InitialConditionFile: can not open " << file_name;
+        music_message.flush("error");
+        exit(1);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    void *mapped = MAP_FAILED;
+    if (size_ >= container_fixed_header_size) {
+        mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED
+            || std::memcmp(mapped, container_magic, 8) != 0) {
+        if (mapped != MAP_FAILED) munmap(mapped, size_);
+        music_message << "InitialConditionFile: " << file_name
+                      << " is not a MUSIC initial-condition container";
+        music_message.flush("error");
+        exit(1);
+    }
+    data_ = static_cast<const char*>(mapped);
+
+    int32_t header[6];
+    double spacings[3];
+    std::memcpy(header, data_ + 8, sizeof(header));
+    std::memcpy(spacings, data_ + 8 + sizeof(header), sizeof(spacings));
+    precision_ = header[1];
+    nx_   = header[2];
+    ny_   = header[3];
+    neta_ = header[4];
+    const int n_fields = header[5];
+    dx_   = spacings[0];
+    dy_   = spacings[1];
+    deta_ = spacings[2];
+
+    const size_t header_size = (container_fixed_header_size
+                                + n_fields*field_name_length);
+    const size_t payload_size = (static_cast<size_t>(n_fields)*nx_*ny_*neta_
+                                 *precision_);
+    if (header[0] != container_version
+            || (precision_ != 4 && precision_ != 8)
+            || nx_ < 1 || ny_ < 1 || neta_ < 1 || n_fields < 1
+            || size_ < header_size + payload_size) {
+        music_message << "InitialConditionFile: the header of " << file_name
+                      << " is not valid or the file is truncated";
+        music_message.flush("error");
+        exit(1);
+    }
+    const char *names = data_ + container_fixed_header_size;
+    for (int i = 0; i < n_fields; i++) {
+        const char *name = names + i*field_name_length;
+        field_names_.push_back(
+            std::string(name, strnlen(name, field_name_length)));
+    }
+    payload_ = data_ + header_size;
+}
+
+
+InitialConditionFile::~InitialConditionFile() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+
+bool InitialConditionFile::is_container(const std::string &file_name) {
+    std::ifstream file(file_name.c_str(), std::ios::binary);
+    char magic[8];
+    file.read(magic, 8);
+    return(file.gcount() == 8 && std::memcmp(magic, container_magic, 8) == 0);
+}
+
+
+void InitialConditionFile::write(
+        const std::string &file_name, const int precision,
+        const int nx, const int ny, const int neta,
+        const double dx, const double dy, const double deta,
+        const std::vector<std::string> &field_names,
+        const std::vector<std::vector<double>> &fields) {
+    pretty_ostream music_message;
+    const size_t n_cells = static_cast<size_t>(nx)*ny*neta;
+    bool valid = ((precision == 4 || precision == 8)
+                  && field_names.size() == fields.size());
+    for (unsigned int i = 0; i < fields.size(); i++) {
+        valid = (valid && fields[i].size() == n_cells
+                 && field_names[i].size() <= field_name_length);
+    }
+    if (!valid) {
+        music_message << "InitialConditionFile::write: the fields for "
+                      << file_name << " do not match the header";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    std::ofstream file(file_name.c_str(), std::ios::binary);
+    const int32_t header[6] = {container_version, precision, nx, ny, neta,
+                               static_cast<int32_t>(fields.size())};
+    const double spacings[3] = {dx, dy, deta};
+    file.write(container_magic, 8);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(spacings), sizeof(spacings));
+    for (const auto &name : field_names) {
+        char padded[field_name_length] = {0};
+        std::memcpy(padded, name.c_str(), name.size());
+        file.write(padded, field_name_length);
+    }
+    for (const auto &field : fields) {
+        if (precision == 4) {
+            std::vector<float> values(field.begin(), field.end());
+            file.write(reinterpret_cast<const char*>(values.data()),
+                       values.size()*sizeof(float));
+        } else {
+            file.write(reinterpret_cast<const char*>(field.data()),
+                       field.size()*sizeof(double));
+        }
+    }
+    if (!file) {
+        music_message << "InitialConditionFile::write: can not write "
+                      << file_name;
+        music_message.flush("error");
+        exit(1);
+    }
+}
+
+
+int InitialConditionFile::get_field_index(const std::string &name) const {
+    for (unsigned int i = 0; i < field_names_.size(); i++) {
+        if (field_names_[i] == name) return(i);
+    }
+    return(-1);
+}
+
+
+int InitialConditionFile::require_field(const std::string &name) const {
+    const int i_field = get_field_index(name);
+    if (i_field < 0) {
+        pretty_ostream music_message;
+        music_message << "InitialConditionFile: the field " << name
+                      << " is not in " << file_name_;
+        music_message.flush("error");
+        exit(1);
+    }
+    return(i_field);
+}
+
+
+TEST_CASE("check the initial-condition container") {
+    const std::string file_name = "test_initial_condition.bin";
+    const int nx = 3, ny = 4, neta = 2;
+    std::vector<std::vector<double>> fields(2,
+                                            std::vector<double>(nx*ny*neta));
+    for (int idx = 0; idx < nx*ny*neta; idx++) {
+        fields[0][idx] = 0.5*idx;
+        fields[1][idx] = 1./(idx + 3.);
+    }
+    for (const int precision : {4, 8}) {
+        InitialConditionFile::write(file_name, precision, nx, ny, neta,
+                                    0.1, 0.2, 0.3, {"ed", "rhob"}, fields);
+        CHECK(InitialConditionFile::is_container(file_name));
+        InitialConditionFile file(file_name);
+        CHECK(file.get_nx() == nx);
+        CHECK(file.get_ny() == ny);
+        CHECK(file.get_neta() == neta);
+        CHECK(file.get_deta() == 0.3);
+        CHECK(file.get_precision() == precision);
+        CHECK(file.get_field_index("rhob") == 1);
+        CHECK(file.get_field_index("ux") == -1);
+        const double rhob = file.get_value(1, 2, 3, 1);
+        const double rhob_ref = fields[1][(1*nx + 2)*ny + 3];
+        if (precision == 8) {
+            CHECK(rhob == rhob_ref);
+        } else {
+            CHECK(rhob == static_cast<float>(rhob_ref));
+        }
+        CHECK(file.get_value(0, 1, 2, 0) == fields[0][1*ny + 2]);
+    }
+    std::remove(file_name.c_str());
+    CHECK(!InitialConditionFile::is_container(file_name));
+}
@@ -0,0 +1,86 @@
+// Copyright @ Bjoern Schenke, Sangyong Jeon, Charles Gale, and Chun Shen
+#ifndef SRC_INITIAL_CONDITION_FILE_H_
+#define SRC_INITIAL_CONDITION_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//! The binary initial-condition container of MUSIC. The file is
+//! memory-mapped read-only and the fields are read in place. Layout, in
+//! the byte order of the machine that wrote it:
+//!     char[8]     "MUSICIC1"
+//!     int32       version (1)
+//!     int32       precision of the payload, 4 (float) or 8 (double)
+//!     int32       nx, ny, neta
+//!     int32       n_fields
+//!     float64     dx, dy, deta
+//!     char[16]    name of each field, padded with '\0'
+//!     payload     n_fields blocks of nx*ny*neta values. Within a block the
+//!                 values are ordered like the text files,
+//!                 idx = (ieta*nx + ix)*ny + iy
+//! MUSIC in running mode 74 converts the text initial conditions into
+//! this format, see Init::convert_initial_condition
+class InitialConditionFile {
+ private:
+    std::string file_name_;
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    const char *payload_ = nullptr;
+
+    int precision_ = 8;
+    int nx_ = 0;
+    int ny_ = 0;
+    int neta_ = 0;
+    double dx_ = 0.;
+    double dy_ = 0.;
+    double deta_ = 0.;
+    std::vector<std::string> field_names_;
+
+ public:
+    static const int field_name_length = 16;
+
+    explicit InitialConditionFile(const std::string &file_name);
+    ~InitialConditionFile();
+    InitialConditionFile(const InitialConditionFile&) = delete;
+    InitialConditionFile& operator=(const InitialConditionFile&) = delete;
+
+    //! returns true if the file starts with the magic of the container
+    static bool is_container(const std::string &file_name);
+
+    //! writes the fields (each of nx*ny*neta values) to a container
+    static void write(const std::string &file_name, int precision,
+                      int nx, int ny, int neta,
+                      double dx, double dy, double deta,
+                      const std::vector<std::string> &field_names,
+                      const std::vector<std::vector<double>> &fields);
+
+    int get_nx()   const {return(nx_);}
+    int get_ny()   const {return(ny_);}
+    int get_neta() const {return(neta_);}
+    double get_dx()   const {return(dx_);}
+    double get_dy()   const {return(dy_);}
+    double get_deta() const {return(deta_);}
+    int get_precision() const {return(precision_);}
+    const std::vector<std::string> &get_field_names() const {
+        return(field_names_);
+    }
+
+    //! returns the index of a field, or -1 if it is not in the file
+    int get_field_index(const std::string &name) const;
+
+    //! returns the index of a field and stops if it is not in the file
+    int require_field(const std::string &name) const;
+
+    double get_value(const int i_field, const int ix, const int iy,
+                     const int ieta) const {
+        const size_t idx = (
+            (static_cast<size_t>(i_field)*neta_ + ieta)*nx_ + ix)*ny_ + iy;
+        if (precision_ == 4) {
+            return(reinterpret_cast<const float*>(payload_)[idx]);
+        }
+        return(reinterpret_cast<const double*>(payload_)[idx]);
+    }
+};
+
+#endif  // SRC_INITIAL_CONDITION_FILE_H_
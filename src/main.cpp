@@ -22,7 +22,9 @@ int main(int argc, char *argv[]) {
     MUSIC music_hydro(input_file);
     int running_mode = music_hydro.get_running_mode();
 
-    if (running_mode == 1 || running_mode == 2) {
+    if (running_mode == 2 && music_hydro.is_ensemble_run()) {
+        music_hydro.run_ensemble();
+    } else if (running_mode == 1 || running_mode == 2) {
         music_hydro.initialize_hydro();
         music_hydro.run_hydro();
     }
@@ -35,9 +37,15 @@ int main(int argc, char *argv[]) {
     if (running_mode == 71) {
         music_hydro.check_eos();
     }
+    if (running_mode == 72) {
+        music_hydro.output_eos_tables();
+    }
     if (running_mode == 73) {
         music_hydro.output_transport_coefficients();
     }
+    if (running_mode == 74) {
+        music_hydro.convert_initial_condition();
+    }
 
     return(0);
 }  /* main */
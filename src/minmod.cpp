@@ -1,3 +1,5 @@
+#include <random>
+#include <vector>
 #include "util.h"
 #include "doctest.h"
 #include "minmod.h"
@@ -24,3 +26,29 @@ TEST_CASE("Does Minmod work") {
     test_dx = test.minmod_dx(0.0, 1.9, 2.0);
     CHECK(test_dx == doctest::Approx(-0.18).epsilon(0.0001));
 }
+
+TEST_CASE("Does the pencil Minmod agree with the scalar one") {
+    Minmod test(1.8);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    const int n = 1000;
+    std::vector<double> up1(n), u(n), um1(n), slope(n);
+    for (int i = 0; i < n; i++) {
+        up1[i] = uniform(rng);
+        u[i]   = uniform(rng);
+        um1[i] = uniform(rng);
+        // flat, monotonic and extremal stencils
+        if (i % 10 == 0) up1[i] = u[i];
+        if (i % 10 == 1) um1[i] = u[i];
+        if (i % 10 == 2) up1[i] = um1[i] = u[i];
+        if (i % 10 == 3) um1[i] = up1[i];
+        if (i % 10 == 4) {
+            up1[i] = u[i] + std::abs(up1[i]);
+            um1[i] = u[i] - std::abs(um1[i]);
+        }
+    }
+    test.minmod_dx(up1.data(), u.data(), um1.data(), slope.data(), n);
+    for (int i = 0; i < n; i++) {
+        CHECK(slope[i] == test.minmod_dx(up1[i], u[i], um1[i]));
+    }
+}
@@ -2,6 +2,7 @@
 #ifndef SRC_MINMOD_H_
 #define SRC_MINMOD_H_
 
+#include <algorithm>
 #include "data.h"
 #include "iostream"
 class Minmod {
@@ -37,6 +38,25 @@ class Minmod {
 	  return diffup*std::max(0., std::min(1.,std::min(diffdown/diffup, diffmid/diffup)));
     }/* minmod_dx */
 
+    //! minmod_dx for a pencil of n values, slope[i] = minmod_dx(up1[i], u[i],
+    //! um1[i]). The zero-slope case is a masked select instead of a branch,
+    //! so that the loop vectorizes over cells and fields. The result is
+    //! bitwise identical to the scalar version
+    void minmod_dx(const double *up1, const double *u, const double *um1,
+                   double *slope, const int n) const {
+        #pragma omp simd
+        for (int i = 0; i < n; i++) {
+            const double diffup   = (up1[i] - u[i])*theta_flux;
+            const double diffdown = (u[i] - um1[i])*theta_flux;
+            const double diffmid  = (up1[i] - um1[i])*0.5;
+            const bool flat = (diffup == 0.);
+            const double denom = flat ? 1. : diffup;
+            const double limited = diffup*std::max(0., std::min(1.,
+                            std::min(diffdown/denom, diffmid/denom)));
+            slope[i] = flat ? 0. : limited;
+        }
+    }
+
 };
 
 #endif  // SRC_MINMOD_H_
@@ -2,6 +2,8 @@
 // Massively cleaned up and improved by Chun Shen 2015-2016
 #include <stdio.h>
 #include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <memory>
 
@@ -15,11 +17,16 @@
 #include "hydro_source_strings.h"
 #include "hydro_source_ampt.h"
 
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
 using std::vector;
 
 MUSIC::MUSIC(std::string input_file) :
     DATA(ReadInParameters::read_in_parameters(input_file)),
-    eos(DATA.whichEOS) {
+    eos(DATA.whichEOS, DATA.eos_interpolation_order,
+        DATA.eos_resample_tolerance, DATA.eos_derivative_tables == 1) {
 
     mode                   = DATA.mode;
     flag_hydro_run         = 0;
@@ -38,6 +45,7 @@ MUSIC::MUSIC(std::string input_file) :
 
 
 MUSIC::~MUSIC() {
+    Init::unbind_threads();
 }
 
 
@@ -70,6 +78,8 @@ void MUSIC::clean_all_the_surface_files() {
 //! This function change the parameter value in DATA
 void MUSIC::set_parameter(std::string parameter_name, double value) {
     ReadInParameters::set_parameter(DATA, parameter_name, value);
+    // the evolution helpers are set up again with the new parameters
+    evolve_ptr.reset();
 }
 
 
@@ -83,15 +93,103 @@ void MUSIC::initialize_hydro() {
 }
 
 
+//! This function prepares a new event with the same grid, EoS and
+//! parameters. The grids are reused by the next initialization if the
+//! size does not change, and the helpers of the evolution by run_hydro
+void MUSIC::reset_for_new_event() {
+    flag_hydro_initialized = 0;
+    flag_hydro_run         = 0;
+    if (hydro_info_ptr != nullptr) {
+        hydro_info_ptr->clean_hydro_event();
+    }
+    // the source terms of the dynamical initializations are read again
+    if (DATA.Initial_profile == 13 || DATA.Initial_profile == 30) {
+        hydro_source_terms_ptr = nullptr;
+        generate_hydro_source_terms();
+    }
+}
+
+
 //! this is a shell function to run hydro
 int MUSIC::run_hydro() {
-    Evolve evolve_local(eos, DATA, hydro_source_terms_ptr);
+    if (evolve_ptr == nullptr) {
+        evolve_ptr.reset(new Evolve(eos, DATA, hydro_source_terms_ptr));
+    } else {
+        evolve_ptr->set_hydro_source_terms(hydro_source_terms_ptr);
+    }
 
     if (hydro_info_ptr == nullptr && DATA.store_hydro_info_in_memory == 1) {
         hydro_info_ptr = std::make_shared<HydroinfoMUSIC> ();
     }
-    evolve_local.EvolveIt(arena_prev, arena_current, arena_future,
-                          (*hydro_info_ptr));
+    evolve_ptr->EvolveIt(arena_prev, arena_current, arena_future,
+                         (*hydro_info_ptr));
+    Init::unbind_threads();
+    flag_hydro_run = 1;
+    return(0);
+}
+
+
+//! This function evolves every initial condition in
+//! DATA.ensemble_event_list as its own event, with the output files in
+//! the directory event_<n>. ensemble_concurrent_events events run at the
+//! same time, each on its share of the OpenMP threads, and take the next
+//! event from a shared counter when they finish. All the events share the
+//! EoS, every concurrent slot keeps its grids and evolution helpers
+int MUSIC::run_ensemble() {
+    const vector<std::string> event_files = (
+        ReadInParameters::read_ensemble_event_list(DATA.ensemble_event_list));
+    const int n_events = event_files.size();
+    const int n_slots = std::max(
+        1, std::min(DATA.ensemble_concurrent_events, n_events));
+    int n_threads = 1;
+#ifdef _OPENMP
+    // the events run in a nested parallel region, the setting of the
+    // caller is restored at the end
+    n_threads = omp_get_max_threads();
+    const int max_active_levels_saved = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(2, max_active_levels_saved));
+#endif
+    const int threads_per_event = std::max(1, n_threads/n_slots);
+    music_message << "Ensemble of " << n_events << " events, " << n_slots
+                  << " at a time with " << threads_per_event
+                  << " threads each";
+    music_message.flush("info");
+
+    std::atomic<int> next_event(0);
+    #pragma omp parallel num_threads(n_slots)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(threads_per_event);
+#endif
+        InitData event_data = DATA;
+        SCGrid event_prev, event_current, event_future;
+        std::unique_ptr<Evolve> event_evolve;
+        HydroinfoMUSIC event_hydro_info;
+        for (int iev = next_event++; iev < n_events; iev = next_event++) {
+            // the initialization may change the lattice in DATA
+            event_data = DATA;
+            if (DATA.Initial_profile == 11) {
+                // a container with all the profiles of the event
+                event_data.initName_TA = event_files[iev];
+            } else {
+                event_data.initName = event_files[iev];
+            }
+            event_data.output_directory = "event_" + std::to_string(iev) + "/";
+            mkdir(event_data.output_directory.c_str(), 0755);
+
+            Init initialization(eos, event_data, nullptr);
+            initialization.InitArena(event_prev, event_current, event_future);
+            if (event_evolve == nullptr) {
+                event_evolve.reset(new Evolve(eos, event_data, nullptr));
+            }
+            event_evolve->EvolveIt(event_prev, event_current, event_future,
+                                   event_hydro_info);
+            event_hydro_info.clean_hydro_event();
+        }
+    }
+#ifdef _OPENMP
+    omp_set_max_active_levels(max_active_levels_saved);
+#endif
     flag_hydro_run = 1;
     return(0);
 }
@@ -112,6 +210,14 @@ void MUSIC::check_eos() {
     eos.check_eos();
 }
 
+//! This function outputs the EoS tables as used in the simulation,
+//! e.g. after resampling with EOS_resample_tolerance
+void MUSIC::output_eos_tables() {
+    music_message << "output the resampled eos tables ...";
+    music_message.flush("info");
+    eos.output_tables("EOS_resampled");
+}
+
 //! this is a test function to output the transport coefficients as
 //! function of T and mu_B
 void MUSIC::output_transport_coefficients() {
@@ -125,17 +231,17 @@ void MUSIC::output_transport_coefficients() {
 }
 
 
-void MUSIC::initialize_hydro_from_jetscape_preequilibrium_vectors(
+//! This function converts the text initial condition of Initial_profile
+//! into the binary InitialConditionFile format
+void MUSIC::convert_initial_condition() {
+    Init initialization(eos, DATA, hydro_source_terms_ptr);
+    initialization.convert_initial_condition();
+}
+
+
+void MUSIC::initialize_hydro_from_jetscape_preequilibrium(
         const double dx, const double dz, const double z_max, const int nz,
-        vector<double> e_in,
-        vector<double> u_tau_in, vector<double> u_x_in,
-        vector<double> u_y_in,   vector<double> u_eta_in,
-        vector<double> pi_00_in, vector<double> pi_01_in,
-        vector<double> pi_02_in, vector<double> pi_03_in,
-        vector<double> pi_11_in, vector<double> pi_12_in,
-        vector<double> pi_13_in, vector<double> pi_22_in,
-        vector<double> pi_23_in, vector<double> pi_33_in,
-        vector<double> Bulk_pi_in) {
+        const PreequilibriumFields &fields) {
 
     DATA.Initial_profile = 42;
     clean_all_the_surface_files();
@@ -150,14 +256,61 @@ void MUSIC::initialize_hydro_from_jetscape_preequilibrium_vectors(
     DATA.delta_y = dx;
 
     Init initialization(eos, DATA, hydro_source_terms_ptr);
-    initialization.get_jetscape_preequilibrium_vectors(
-        e_in, u_tau_in, u_x_in, u_y_in, u_eta_in,
-        pi_00_in, pi_01_in, pi_02_in, pi_03_in, pi_11_in, pi_12_in, pi_13_in,
-        pi_22_in, pi_23_in, pi_33_in, Bulk_pi_in);
+    initialization.set_jetscape_preequilibrium_fields(fields);
     initialization.InitArena(arena_prev, arena_current, arena_future);
     flag_hydro_initialized = 1;
 }
 
+
+void MUSIC::initialize_hydro_from_jetscape_preequilibrium_vectors(
+        const double dx, const double dz, const double z_max, const int nz,
+        const vector<double> &e_in,
+        const vector<double> &u_tau_in, const vector<double> &u_x_in,
+        const vector<double> &u_y_in,   const vector<double> &u_eta_in,
+        const vector<double> &pi_00_in, const vector<double> &pi_01_in,
+        const vector<double> &pi_02_in, const vector<double> &pi_03_in,
+        const vector<double> &pi_11_in, const vector<double> &pi_12_in,
+        const vector<double> &pi_13_in, const vector<double> &pi_22_in,
+        const vector<double> &pi_23_in, const vector<double> &pi_33_in,
+        const vector<double> &Bulk_pi_in) {
+    PreequilibriumFields fields;
+    fields.n_cells = e_in.size();
+    bool valid = true;
+    // a required field must have n_cells values, an optional one may be
+    // empty
+    auto pointer_to = [&fields, &valid](const vector<double> &field,
+                                        const bool required) {
+        if (field.size() == fields.n_cells) return(field.data());
+        if (required || !field.empty()) valid = false;
+        return(static_cast<const double*>(nullptr));
+    };
+    fields.e       = pointer_to(e_in, true);
+    fields.u_tau   = pointer_to(u_tau_in, true);
+    fields.u_x     = pointer_to(u_x_in, true);
+    fields.u_y     = pointer_to(u_y_in, true);
+    fields.u_eta   = pointer_to(u_eta_in, true);
+    fields.pi_00   = pointer_to(pi_00_in, false);
+    fields.pi_01   = pointer_to(pi_01_in, false);
+    fields.pi_02   = pointer_to(pi_02_in, false);
+    fields.pi_03   = pointer_to(pi_03_in, false);
+    fields.pi_11   = pointer_to(pi_11_in, false);
+    fields.pi_12   = pointer_to(pi_12_in, false);
+    fields.pi_13   = pointer_to(pi_13_in, false);
+    fields.pi_22   = pointer_to(pi_22_in, false);
+    fields.pi_23   = pointer_to(pi_23_in, false);
+    fields.pi_33   = pointer_to(pi_33_in, false);
+    fields.bulk_pi = pointer_to(Bulk_pi_in, false);
+    if (!valid) {
+        music_message << "initialize_hydro_from_jetscape_preequilibrium_"
+                      << "vectors: the fields do not all have "
+                      << fields.n_cells << " values";
+        music_message.flush("error");
+        exit(1);
+    }
+    initialize_hydro_from_jetscape_preequilibrium(dx, dz, z_max, nz, fields);
+}
+
+
 void MUSIC::get_hydro_info(
         const double x, const double y, const double z, const double t,
         fluidCell* fluid_cell_info) {
@@ -171,6 +324,21 @@ void MUSIC::get_hydro_info(
     hydro_info_ptr->getHydroValues(x, y, z, t, fluid_cell_info);
 }
 
+
+int MUSIC::get_hydro_info(const int n, const double *x, const double *y,
+                          const double *z, const double *t,
+                          fluidCell *fluid_cell_info) const {
+    if (DATA.store_hydro_info_in_memory == 0 || hydro_info_ptr == nullptr) {
+        pretty_ostream error_message;
+        error_message << "hydro evolution information is not stored "
+                      << "in the memory! Please set the parameter "
+                      << "store_hydro_info_in_memory to 1~";
+        error_message.flush("error");
+        exit(1);
+    }
+    return(hydro_info_ptr->getHydroValues(n, x, y, z, t, fluid_cell_info));
+}
+
 void MUSIC::clear_hydro_info_from_memory() {
     if (DATA.store_hydro_info_in_memory == 0 || hydro_info_ptr == nullptr) {
         music_message << "The parameter store_hydro_info_in_memory is 0. "
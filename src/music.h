@@ -14,6 +14,8 @@
 #include "pretty_ostream.h"
 #include "HydroinfoMUSIC.h"
 
+class Evolve;
+
 //! This is a wrapper class for the MUSIC hydro
 class MUSIC {
  private:
@@ -38,6 +40,9 @@ class MUSIC {
 
     std::shared_ptr<HydroinfoMUSIC> hydro_info_ptr;
 
+    //! the evolution helpers, kept between the events of this instance
+    std::unique_ptr<Evolve> evolve_ptr;
+
     pretty_ostream music_message;
 
  public:
@@ -50,15 +55,26 @@ class MUSIC {
     //! This function initialize hydro
     void initialize_hydro();
 
+    //! This function prepares a new event with the same grid, EoS and
+    //! parameters, reusing the grids, the EoS tables and the helpers of
+    //! the evolution
+    void reset_for_new_event();
+
     //! This function change the parameter value in DATA
     void set_parameter(std::string parameter_name, double value);
 
     //! this is a shell function to run hydro
     int run_hydro();
 
+    //! this function evolves the events of ensemble_event_list
+    int run_ensemble();
+
     //! this is a shell function to run Cooper-Frye
     int run_Cooper_Frye();
 
+    //! returns true if the input file lists the events of an ensemble
+    bool is_ensemble_run() const {return(DATA.ensemble_event_list != "");}
+
     //! this function adds hydro source terms pointer
     void add_hydro_source_terms(
             std::shared_ptr<HydroSourceBase> hydro_source_ptr_in);
@@ -69,27 +85,55 @@ class MUSIC {
     //! This function calls routine to check EoS
     void check_eos();
 
+    //! This function outputs the (resampled) EoS tables
+    void output_eos_tables();
+
     //! this is a test function to output the transport coefficients as
     //! function of T and mu_B
     void output_transport_coefficients();
 
+    //! This function converts the text initial condition into the binary
+    //! InitialConditionFile format
+    void convert_initial_condition();
+
     void clean_all_the_surface_files();
 
+    //! This function initializes hydro with the pre-equilibrium fields
+    //! of JETSCAPE. The buffers of the caller are read in place and are
+    //! not needed after the function returns
+    void initialize_hydro_from_jetscape_preequilibrium(
+        const double dx, const double dz, const double z_max, const int nz,
+        const PreequilibriumFields &fields);
+
+    //! The same with the fields as vectors, the viscous ones may be empty
     void initialize_hydro_from_jetscape_preequilibrium_vectors(
         const double dx, const double dz, const double z_max, const int nz,
-        std::vector<double> e_in,
-        std::vector<double> u_tau_in, std::vector<double> u_x_in,
-        std::vector<double> u_y_in,   std::vector<double> u_eta_in,
-        std::vector<double> pi_00_in, std::vector<double> pi_01_in,
-        std::vector<double> pi_02_in, std::vector<double> pi_03_in,
-        std::vector<double> pi_11_in, std::vector<double> pi_12_in,
-        std::vector<double> pi_13_in, std::vector<double> pi_22_in,
-        std::vector<double> pi_23_in, std::vector<double> pi_33_in,
-        std::vector<double> Bulk_pi_in);
+        const std::vector<double> &e_in,
+        const std::vector<double> &u_tau_in,
+        const std::vector<double> &u_x_in,
+        const std::vector<double> &u_y_in,
+        const std::vector<double> &u_eta_in,
+        const std::vector<double> &pi_00_in,
+        const std::vector<double> &pi_01_in,
+        const std::vector<double> &pi_02_in,
+        const std::vector<double> &pi_03_in,
+        const std::vector<double> &pi_11_in,
+        const std::vector<double> &pi_12_in,
+        const std::vector<double> &pi_13_in,
+        const std::vector<double> &pi_22_in,
+        const std::vector<double> &pi_23_in,
+        const std::vector<double> &pi_33_in,
+        const std::vector<double> &Bulk_pi_in);
 
     void get_hydro_info(
         const double x, const double y, const double z, const double t,
         fluidCell* fluid_cell_info);
+    //! batched version of get_hydro_info for n points, which can be called
+    //! from several threads at the same time. Returns the number of points
+    //! outside of the stored evolution, their cells are set to 0
+    int get_hydro_info(const int n, const double *x, const double *y,
+                       const double *z, const double *t,
+                       fluidCell *fluid_cell_info) const;
     int get_number_of_fluid_cells() const {
         return(hydro_info_ptr->get_number_of_fluid_cells());
     }
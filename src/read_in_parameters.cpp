@@ -1,7 +1,12 @@
 
 #include <iostream>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 #include "./read_in_parameters.h"
+#include "./initial_condition_file.h"
+#include "doctest.h"
 
 using namespace std;
 
@@ -9,49 +14,100 @@ namespace ReadInParameters {
 
 pretty_ostream music_message;
 
+ParameterTable::ParameterTable(std::string input_file) {
+    for (const auto &parameter : Util::ReadParameterFile(input_file)) {
+        names_.push_back(parameter.first);
+        values_.insert(parameter);
+    }
+}
+
+
+std::string ParameterTable::find(const std::string &name) {
+    known_.insert(name);
+    auto it = values_.find(name);
+    if (it == values_.end()) return("empty");
+    return(it->second);
+}
+
+
+//! marks parameters as known that are only looked up for some settings
+void ParameterTable::mark_known(const std::vector<std::string> &names) {
+    known_.insert(names.begin(), names.end());
+}
+
+
+//! returns the parameters of the file that were never looked up,
+//! in the order of the file
+std::vector<std::string> ParameterTable::get_unknown_names() const {
+    std::vector<std::string> unknown;
+    std::unordered_set<std::string> listed;
+    for (const auto &name : names_) {
+        if (known_.count(name) == 0 && listed.insert(name).second)
+            unknown.push_back(name);
+    }
+    return(unknown);
+}
+
+
+//! returns the parameters that are set more than once in the file
+std::vector<std::string> ParameterTable::get_repeated_names() const {
+    std::vector<std::string> repeated;
+    std::unordered_set<std::string> seen;
+    std::unordered_set<std::string> listed;
+    for (const auto &name : names_) {
+        if (!seen.insert(name).second && listed.insert(name).second)
+            repeated.push_back(name);
+    }
+    return(repeated);
+}
+
+
 InitData read_in_parameters(std::string input_file) {
     InitData parameter_list;
 
+    // the input file is read once, all the parameters are looked up in it
+    ParameterTable input_parameters(input_file);
+
     // this function reads in parameters
     string tempinput;
 
     // echo_level controls the mount of
     // warning message output during the evolution
     double temp_echo_level = 9;
-    tempinput = Util::StringFind4(input_file, "echo_level");
+    tempinput = input_parameters.find("echo_level");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_echo_level;
     parameter_list.echo_level = temp_echo_level;
 
     // Initial_profile:
     int tempInitial_profile = 1;
-    tempinput = Util::StringFind4(input_file, "Initial_profile");
+    tempinput = input_parameters.find("Initial_profile");
     if (tempinput != "empty") istringstream(tempinput) >> tempInitial_profile;
     parameter_list.Initial_profile = tempInitial_profile;
 
     // Initial_profile: 
     int temp_string_dump_mode = 1;
-    tempinput = Util::StringFind4(input_file, "string_dump_mode");
+    tempinput = input_parameters.find("string_dump_mode");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_string_dump_mode;
     parameter_list.string_dump_mode = temp_string_dump_mode;
 
     // hydro source
     double temp_string_quench_factor = 0.;
-    tempinput = Util::StringFind4(input_file, "string_quench_factor");
+    tempinput = input_parameters.find("string_quench_factor");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_string_quench_factor;
     parameter_list.string_quench_factor = temp_string_quench_factor;
 
     // hydro source
     double temp_parton_quench_factor = 1.;
-    tempinput = Util::StringFind4(input_file, "parton_quench_factor");
+    tempinput = input_parameters.find("parton_quench_factor");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_parton_quench_factor;
     parameter_list.parton_quench_factor = temp_parton_quench_factor;
 
     // boost-invariant
     int temp_boost_invariant = 1;
-    tempinput = Util::StringFind4(input_file, "boost_invariant");
+    tempinput = input_parameters.find("boost_invariant");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_boost_invariant;
     if (temp_boost_invariant == 0) {
@@ -61,8 +117,7 @@ InitData read_in_parameters(std::string input_file) {
     }
 
     int temp_output_initial_profile = 0;
-    tempinput = Util::StringFind4(input_file,
-                                  "output_initial_density_profiles");
+    tempinput = input_parameters.find("output_initial_density_profiles");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_output_initial_profile;
     parameter_list.output_initial_density_profiles =
@@ -72,14 +127,14 @@ InitData read_in_parameters(std::string input_file) {
     //1 for Hirano's central plateau + Gaussian decay
     //2 for a Woods-Saxon proinput_file
     int tempinitial_eta_profile = 1;
-    tempinput = Util::StringFind4(input_file, "initial_eta_profile");
+    tempinput = input_parameters.find("initial_eta_profile");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempinitial_eta_profile;
     parameter_list.initial_eta_profile = tempinitial_eta_profile;
 
     // eta envelope function parameter for rhob
     int temp_rhob_flag = 1;
-    tempinput = Util::StringFind4(input_file, "initial_eta_rhob_profile");
+    tempinput = input_parameters.find("initial_eta_rhob_profile");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_rhob_flag;
     parameter_list.initial_eta_rhob_profile = temp_rhob_flag;
@@ -88,7 +143,7 @@ InitData read_in_parameters(std::string input_file) {
     //0: scale with energy density
     //1: scale with entropy density
     int tempinitializeEntropy = 0;
-    tempinput = Util::StringFind4(input_file, "initialize_with_entropy");
+    tempinput = input_parameters.find("initialize_with_entropy");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempinitializeEntropy;
     parameter_list.initializeEntropy = tempinitializeEntropy;
@@ -98,7 +153,7 @@ InitData read_in_parameters(std::string input_file) {
     // 1: freeze out at constant energy density epsilon_freeze
     // if set in input input_file, overide above defaults
     int tempuseEpsFO = 1;
-    tempinput = Util::StringFind4(input_file, "use_eps_for_freeze_out");
+    tempinput = input_parameters.find("use_eps_for_freeze_out");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempuseEpsFO;
     parameter_list.useEpsFO = tempuseEpsFO;
@@ -107,7 +162,7 @@ InitData read_in_parameters(std::string input_file) {
     // only used with use_eps_for_freeze_out = 0
     double tempTFO = 0.12;
     if (parameter_list.useEpsFO == 0) {
-        tempinput = Util::StringFind4(input_file, "T_freeze");
+        tempinput = input_parameters.find("T_freeze");
         if (tempinput != "empty") {
             istringstream(tempinput) >> tempTFO;
         } else {
@@ -120,45 +175,45 @@ InitData read_in_parameters(std::string input_file) {
         // epsilon_freeze: freeze-out energy density in GeV/fm^3
         // only used with use_eps_for_freeze_out = 1
         double tempepsilonFreeze = 0.12;
-        tempinput = Util::StringFind4(input_file, "epsilon_freeze");
+        tempinput = input_parameters.find("epsilon_freeze");
         if (tempinput != "empty") {
             istringstream(tempinput) >> tempepsilonFreeze;
         }
         parameter_list.epsilonFreeze = tempepsilonFreeze;
 
         int temp_N_freeze_out = 1;
-        tempinput = Util::StringFind4(input_file, "N_freeze_out");
+        tempinput = input_parameters.find("N_freeze_out");
         if (tempinput != "empty")
             istringstream(tempinput) >> temp_N_freeze_out;
         parameter_list.N_freeze_out = temp_N_freeze_out;
     }
 
     string temp_freeze_list_filename = "eps_freeze_list_s95p_v1.dat";
-    tempinput = Util::StringFind4(input_file, "freeze_list_filename");
+    tempinput = input_parameters.find("freeze_list_filename");
     if (tempinput != "empty")
         temp_freeze_list_filename.assign(tempinput);
     parameter_list.freeze_list_filename.assign(temp_freeze_list_filename);
 
     double temp_eps_freeze_max = 0.18;
-    tempinput = Util::StringFind4(input_file, "eps_freeze_max");
+    tempinput = input_parameters.find("eps_freeze_max");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_eps_freeze_max;
     parameter_list.eps_freeze_max = temp_eps_freeze_max;
 
     double temp_eps_freeze_min = 0.18;
-    tempinput = Util::StringFind4(input_file, "eps_freeze_min");
+    tempinput = input_parameters.find("eps_freeze_min");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_eps_freeze_min;
     parameter_list.eps_freeze_min = temp_eps_freeze_min;
 
     int temp_freeze_eps_flag = 0;
-    tempinput = Util::StringFind4(input_file, "freeze_eps_flag");
+    tempinput = input_parameters.find("freeze_eps_flag");
     if (tempinput != "empty")
         istringstream (tempinput) >> temp_freeze_eps_flag;
     parameter_list.freeze_eps_flag = temp_freeze_eps_flag;
 
     int temp_freeze_surface_binary = 1;
-    tempinput = Util::StringFind4(input_file, "freeze_surface_in_binary");
+    tempinput = input_parameters.find("freeze_surface_in_binary");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_freeze_surface_binary;
     if (temp_freeze_surface_binary == 0) {
@@ -171,7 +226,7 @@ InitData read_in_parameters(std::string input_file) {
     // 0: Do all up to number_of_particles_to_include
     // any natural number: Do the particle with this (internal) ID
     int tempparticleSpectrumNumber = 0;
-    tempinput = Util::StringFind4(input_file, "particle_spectrum_to_compute");
+    tempinput = input_parameters.find("particle_spectrum_to_compute");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempparticleSpectrumNumber;
     parameter_list.particleSpectrumNumber = tempparticleSpectrumNumber;
@@ -184,8 +239,12 @@ InitData read_in_parameters(std::string input_file) {
     // 4: Resonance decays only.
     // 13: Compute observables from previously-computed thermal spectra
     // 14: Compute observables from post-decay spectra
+    // 71: Output the EoS
+    // 72: Output the EoS tables after resampling
+    // 73: Output the transport coefficients
+    // 74: Convert the initial condition to the binary format
     int tempmode = 1;
-    tempinput = Util::StringFind4(input_file, "mode");
+    tempinput = input_parameters.find("mode");
     if (tempinput != "empty") {
         istringstream(tempinput) >> tempmode;
     } else {
@@ -209,18 +268,48 @@ InitData read_in_parameters(std::string input_file) {
     // 11: finite muB EOS from Pasi
     // 12: finite muB EOS from A. Monnai (up to mu_B^6)
     int tempwhichEOS = 2;
-    tempinput = Util::StringFind4(input_file, "EOS_to_use");
+    tempinput = input_parameters.find("EOS_to_use");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempwhichEOS;
     parameter_list.whichEOS = tempwhichEOS;
 
+    // EOS_interpolation_order:
+    // 1: linear interpolation in the EoS tables
+    // 3: monotone cubic interpolation in e for the tables at zero mu_B
+    //    dP/de is then the analytic derivative of the interpolation
+    int temp_eos_interpolation_order = 1;
+    tempinput = input_parameters.find("EOS_interpolation_order");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_eos_interpolation_order;
+    parameter_list.eos_interpolation_order = temp_eos_interpolation_order;
+
+    // EOS_resample_tolerance:
+    // if > 0, the EoS tables at zero mu_B are resampled to the coarsest
+    // uniform grid that reproduces all table entries within this
+    // relative tolerance (with the cubic interpolation)
+    double temp_eos_resample_tolerance = 0.;
+    tempinput = input_parameters.find("EOS_resample_tolerance");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_eos_resample_tolerance;
+    parameter_list.eos_resample_tolerance = temp_eos_resample_tolerance;
+
+    // EOS_derivative_tables:
+    // 0: dP/de, dP/drhob and cs^2 from finite differences of the pressure
+    // 1: dP/de, dP/drhob and cs^2 tabulated on the nodes of the pressure
+    //    tables at load, one table lookup each (differences between
+    //    neighbouring nodes, so the values differ slightly from 0)
+    int temp_eos_derivative_tables = 0;
+    tempinput = input_parameters.find("EOS_derivative_tables");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_eos_derivative_tables;
+    parameter_list.eos_derivative_tables = temp_eos_derivative_tables;
+
     // number_of_particles_to_include:
     // This determines up to which particle in the list spectra
     // should be computed (mode=3) or resonances should be included (mode=4)
     // current maximum = 319
     int tempNumberOfParticlesToInclude = 2;
-    tempinput = Util::StringFind4(input_file,
-                                  "number_of_particles_to_include");
+    tempinput = input_parameters.find("number_of_particles_to_include");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempNumberOfParticlesToInclude;
     parameter_list.NumberOfParticlesToInclude = tempNumberOfParticlesToInclude;
@@ -228,7 +317,7 @@ InitData read_in_parameters(std::string input_file) {
     // freeze_out_method:
     // 2: Schenke's more complex method
     int tempfreezeOutMethod = 4;
-    tempinput = Util::StringFind4(input_file, "freeze_out_method");
+    tempinput = input_parameters.find("freeze_out_method");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempfreezeOutMethod;
     parameter_list.freezeOutMethod = tempfreezeOutMethod;
@@ -236,21 +325,21 @@ InitData read_in_parameters(std::string input_file) {
     // average_surface_over_this_many_time_steps:
     // Only save every N timesteps for finding freeze out surface
     int tempfacTau = 1;
-    tempinput = Util::StringFind4(input_file,
+    tempinput = input_parameters.find(
                                   "average_surface_over_this_many_time_steps");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempfacTau;
     parameter_list.facTau = tempfacTau;
 
     int tempfac_x = 1;
-    tempinput = Util::StringFind4(input_file, "freeze_Ncell_x_step");
+    tempinput = input_parameters.find("freeze_Ncell_x_step");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempfac_x;
     parameter_list.fac_x = tempfac_x;
     parameter_list.fac_y = tempfac_x;
 
     int tempfac_eta = 1;
-    tempinput = Util::StringFind4(input_file, "freeze_Ncell_eta_step");
+    tempinput = input_parameters.find("freeze_Ncell_eta_step");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempfac_eta;
     parameter_list.fac_eta = tempfac_eta;
@@ -258,12 +347,12 @@ InitData read_in_parameters(std::string input_file) {
     // Grid_size_in_*
     // number of cells in x,y direction
     int tempnx = 10;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_x");
+    tempinput = input_parameters.find("Grid_size_in_x");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempnx;
     parameter_list.nx = tempnx;
     int tempny = 10;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_y");
+    tempinput = input_parameters.find("Grid_size_in_y");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempny;
     parameter_list.ny = tempny;
@@ -274,7 +363,7 @@ InitData read_in_parameters(std::string input_file) {
     // half the cells are at negative eta,
     // the rest (one fewer) are at positive eta
     int tempneta = 1;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_eta");
+    tempinput = input_parameters.find("Grid_size_in_eta");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempneta;
     parameter_list.neta = tempneta;
@@ -282,19 +371,19 @@ InitData read_in_parameters(std::string input_file) {
     // grid_size_in_fm:
     // total length of box in x,y direction in fm (minus delta_*)
     double tempx_size = 25.;
-    tempinput = Util::StringFind4(input_file, "X_grid_size_in_fm");
+    tempinput = input_parameters.find("X_grid_size_in_fm");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempx_size;
     parameter_list.x_size = tempx_size;
     double tempy_size = 25.;
-    tempinput = Util::StringFind4(input_file, "Y_grid_size_in_fm");
+    tempinput = input_parameters.find("Y_grid_size_in_fm");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempy_size;
     parameter_list.y_size = tempy_size;
 
     // switch for baryon current propagation
     int tempturn_on_rhob = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Rhob_Yes_1_No_0");
+    tempinput = input_parameters.find("Include_Rhob_Yes_1_No_0");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempturn_on_rhob;
     parameter_list.turn_on_rhob = tempturn_on_rhob;
@@ -306,7 +395,7 @@ InitData read_in_parameters(std::string input_file) {
     // Eta_grid_size:  total length of box in eta direction (minus delta_eta)
     // e.g., neta=8 and eta_size=8 has 8 cells that run from eta=-4 to eta=3
     double tempeta_size = 8.;
-    tempinput = Util::StringFind4(input_file, "Eta_grid_size");
+    tempinput = input_parameters.find("Eta_grid_size");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempeta_size;
     parameter_list.eta_size = tempeta_size;
@@ -315,14 +404,14 @@ InitData read_in_parameters(std::string input_file) {
     // total evolution time in [fm]. in case of freeze_out_method = 2,3,
     // evolution will halt earlier if all cells are frozen out.
     double temptau_size = 50.;
-    tempinput = Util::StringFind4(input_file, "Total_evolution_time_tau");
+    tempinput = input_parameters.find("Total_evolution_time_tau");
     if (tempinput != "empty")
         istringstream(tempinput) >> temptau_size;
     parameter_list.tau_size = temptau_size;
 
     // Initial_time_tau_0:  in fm
     double temptau0 = 0.4;
-    tempinput = Util::StringFind4(input_file, "Initial_time_tau_0");
+    tempinput = input_parameters.find("Initial_time_tau_0");
     if (tempinput != "empty")
         istringstream(tempinput) >> temptau0;
     parameter_list.tau0 = temptau0;
@@ -345,7 +434,7 @@ InitData read_in_parameters(std::string input_file) {
     // Delta_Tau: 
     // time step to use in [fm].
     double tempdelta_tau = 0.02;
-    tempinput = Util::StringFind4(input_file, "Delta_Tau");
+    tempinput = input_parameters.find("Delta_Tau");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempdelta_tau;
     parameter_list.delta_tau = tempdelta_tau;
@@ -355,26 +444,37 @@ InitData read_in_parameters(std::string input_file) {
     // output_evolution_data:  
     // 1: output bulk information at every grid point at every time step
     int tempoutputEvolutionData = 0;
-    tempinput = Util::StringFind4(input_file, "output_evolution_data");
+    tempinput = input_parameters.find("output_evolution_data");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempoutputEvolutionData;
     parameter_list.outputEvolutionData = tempoutputEvolutionData;
 
     int temp_store_hydro_info_in_memory = 0;
-    tempinput = Util::StringFind4(input_file, "store_hydro_info_in_memory");
+    tempinput = input_parameters.find("store_hydro_info_in_memory");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_store_hydro_info_in_memory;
     parameter_list.store_hydro_info_in_memory =
                                             temp_store_hydro_info_in_memory;
 
+    // store_hydro_info_precision:
+    // bytes per value of the hydro evolution stored in memory
+    // 4: float
+    // 2: half precision, about 3 significant digits
+    int temp_store_hydro_info_precision = 4;
+    tempinput = input_parameters.find("store_hydro_info_precision");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_store_hydro_info_precision;
+    parameter_list.store_hydro_info_precision =
+                                            temp_store_hydro_info_precision;
+
     int temp_output_movie_flag = 0;
-    tempinput = Util::StringFind4(input_file, "output_movie_flag");
+    tempinput = input_parameters.find("output_movie_flag");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_output_movie_flag;
     parameter_list.output_movie_flag = temp_output_movie_flag;
 
     int temp_output_outofequilibriumsize = 0;
-    tempinput = Util::StringFind4(input_file, "output_outofequilibriumsize");
+    tempinput = input_parameters.find("output_outofequilibriumsize");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_output_outofequilibriumsize;
     parameter_list.output_outofequilibriumsize = (
@@ -390,25 +490,25 @@ InitData read_in_parameters(std::string input_file) {
     music_message.flush("info");
 
     double temp_eta_0 = 3.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_0");
+    tempinput = input_parameters.find("eta_rhob_0");
     if (tempinput != "empty") istringstream (tempinput) >> temp_eta_0;
     parameter_list.eta_rhob_0 = temp_eta_0;
     double temp_eta_width = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width");
+    tempinput = input_parameters.find("eta_rhob_width");
     if (tempinput != "empty") istringstream (tempinput) >> temp_eta_width;
     parameter_list.eta_rhob_width = temp_eta_width;
     double temp_eta_plateau_height = 0.5;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_plateau_height");
+    tempinput = input_parameters.find("eta_rhob_plateau_height");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_eta_plateau_height;
     parameter_list.eta_rhob_plateau_height = temp_eta_plateau_height;
     double temp_eta_width_1 = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width_1");
+    tempinput = input_parameters.find("eta_rhob_width_1");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_eta_width_1;
     parameter_list.eta_rhob_width_1 = temp_eta_width_1;
     double temp_eta_width_2 = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width_2");
+    tempinput = input_parameters.find("eta_rhob_width_2");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_eta_width_2;
     parameter_list.eta_rhob_width_2 = temp_eta_width_2;
@@ -416,7 +516,7 @@ InitData read_in_parameters(std::string input_file) {
     // Eta_fall_off:
     // width of half-Gaussian on each side of a central pleateau in eta
     double tempeta_fall_off  = 0.4;
-    tempinput = Util::StringFind4(input_file, "Eta_fall_off");
+    tempinput = input_parameters.find("Eta_fall_off");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempeta_fall_off ;
     parameter_list.eta_fall_off  = tempeta_fall_off;
@@ -424,14 +524,14 @@ InitData read_in_parameters(std::string input_file) {
     // Eta_plateau_size:
     // width of the flat region symmetrical around eta=0
     double tempeta_flat = 20.0;
-    tempinput = Util::StringFind4(input_file, "Eta_plateau_size");
+    tempinput = input_parameters.find("Eta_plateau_size");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempeta_flat;
     parameter_list.eta_flat = tempeta_flat;
 
     // s_factor:  for use with IP-Glasma initial conditions
     double tempsFactor   = 20.;
-    tempinput = Util::StringFind4(input_file, "s_factor");
+    tempinput = input_parameters.find("s_factor");
     if (tempinput != "empty") istringstream ( tempinput ) >> tempsFactor;
     parameter_list.sFactor   = tempsFactor;
 
@@ -439,7 +539,7 @@ InitData read_in_parameters(std::string input_file) {
     // max_pseudorapidity:
     // spectra calculated from zero to this pseudorapidity in +eta and -eta
     double tempmax_pseudorapidity = 5.0;
-    tempinput = Util::StringFind4(input_file, "max_pseudorapidity");
+    tempinput = input_parameters.find("max_pseudorapidity");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempmax_pseudorapidity;
     parameter_list.max_pseudorapidity = tempmax_pseudorapidity;
@@ -447,7 +547,7 @@ InitData read_in_parameters(std::string input_file) {
     // pseudo_steps:
     // steps in pseudorapidity in calculation of spectra
     int temppseudo_steps = 51;
-    tempinput = Util::StringFind4(input_file, "pseudo_steps");
+    tempinput = input_parameters.find("pseudo_steps");
     if (tempinput != "empty")
         istringstream(tempinput) >> temppseudo_steps;
     parameter_list.pseudo_steps = temppseudo_steps; 
@@ -455,7 +555,7 @@ InitData read_in_parameters(std::string input_file) {
     // phi_steps
     // steps in azimuthal angle in calculation of spectra
     int tempphi_steps = 48;
-    tempinput = Util::StringFind4(input_file, "phi_steps");
+    tempinput = input_parameters.find("phi_steps");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempphi_steps  ;
     parameter_list.phi_steps = tempphi_steps; 
@@ -463,7 +563,7 @@ InitData read_in_parameters(std::string input_file) {
     // min_pt:
     // spectra calculated from this to max_pt transverse momentum in GeV
     double tempmin_pt   = 0.0;
-    tempinput = Util::StringFind4(input_file, "min_pt");
+    tempinput = input_parameters.find("min_pt");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempmin_pt  ;
     parameter_list.min_pt = tempmin_pt;
@@ -471,7 +571,7 @@ InitData read_in_parameters(std::string input_file) {
     // max_pt:
     // spectra calculated from min_pt to this transverse momentum in GeV
     double tempmax_pt   = 3.0;
-    tempinput = Util::StringFind4(input_file, "max_pt");
+    tempinput = input_parameters.find("max_pt");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempmax_pt;
     parameter_list.max_pt = tempmax_pt;
@@ -479,7 +579,7 @@ InitData read_in_parameters(std::string input_file) {
     // pt_steps:
     // steps in transverse momentum in calculation of spectra
     int temppt_steps   = 60;
-    tempinput = Util::StringFind4(input_file, "pt_steps");
+    tempinput = input_parameters.find("pt_steps");
     if (tempinput != "empty")
         istringstream(tempinput) >> temppt_steps  ;
     parameter_list.pt_steps = temppt_steps;   
@@ -488,34 +588,77 @@ InitData read_in_parameters(std::string input_file) {
     // Calculate spectra at fixed,
     // equally-spaced grid in pseudorapidity, pt, and phi
     int temppseudofreeze = 1;
-    tempinput = Util::StringFind4(input_file, "pseudofreeze");
+    tempinput = input_parameters.find("pseudofreeze");
     if (tempinput != "empty")
         istringstream(tempinput) >> temppseudofreeze;
     parameter_list.pseudofreeze = temppseudofreeze;
 
-    // Runge_Kutta_order:  must be 1 or 2
+    // Runge_Kutta_order:  must be 1, 2 or 3
+    // 1: forward Euler, 2: Heun (SSP-RK2), 3: SSP-RK3
     int temprk_order = 2;
-    tempinput = Util::StringFind4(input_file, "Runge_Kutta_order");
+    tempinput = input_parameters.find("Runge_Kutta_order");
     if (tempinput != "empty")
         istringstream(tempinput) >> temprk_order;
     parameter_list.rk_order = temprk_order;
 
     // Minmod_Theta: theta parameter in the min-mod like limiter
     double tempminmod_theta   = 1.8;
-    tempinput = Util::StringFind4(input_file, "Minmod_Theta");
+    tempinput = input_parameters.find("Minmod_Theta");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempminmod_theta  ;
     parameter_list.minmod_theta = tempminmod_theta;
 
+    // flux_sweep_mode:
+    // 0: the KT fluxes are computed cell by cell (each face twice)
+    // 1: the KT fluxes are computed once per face in a separate sweep
+    int temp_flux_sweep_mode = 0;
+    tempinput = input_parameters.find("flux_sweep_mode");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_flux_sweep_mode;
+    parameter_list.flux_sweep_mode = temp_flux_sweep_mode;
+
+    // temporal_blocking_slab:
+    // 0: every Runge-Kutta stage sweeps the full grid
+    // n > 0: the stages run as a wavefront over slabs of n cells in eta,
+    //        so that a slab is still in the cache for the next stage
+    int temp_temporal_blocking_slab = 0;
+    tempinput = input_parameters.find("temporal_blocking_slab");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_temporal_blocking_slab;
+    parameter_list.temporal_blocking_slab = temp_temporal_blocking_slab;
+
+    // omp_thread_binding:
+    // 0: the OpenMP threads are placed by the OpenMP runtime
+    //    (OMP_PROC_BIND, OMP_PLACES)
+    // 1: MUSIC pins its OpenMP threads to the cpus of the process for the
+    //    time of the hydro run, and restores their affinity afterwards
+    int temp_omp_thread_binding = 0;
+    tempinput = input_parameters.find("omp_thread_binding");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_omp_thread_binding;
+    parameter_list.omp_thread_binding = temp_omp_thread_binding;
+
+    // reconst_initial_guess: initial guess of the velocity in the
+    // Newton iterations that reconstruct e, rhob and u^mu from T^{tau mu}
+    // 0: the velocity of the cell at the current time step
+    // 1: the velocity extrapolated linearly from the previous two time
+    //    steps (for the update of the cells in the first RK stage)
+    // 2: the solution at zero net baryon density, tabulated at start-up
+    int temp_reconst_initial_guess = 0;
+    tempinput = input_parameters.find("reconst_initial_guess");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_reconst_initial_guess;
+    parameter_list.reconst_initial_guess = temp_reconst_initial_guess;
+
     // Viscosity_Flag_Yes_1_No_0:   set to 0 for ideal hydro
     int tempviscosity_flag = 1;
-    tempinput = Util::StringFind4(input_file, "Viscosity_Flag_Yes_1_No_0");
+    tempinput = input_parameters.find("Viscosity_Flag_Yes_1_No_0");
     if(tempinput != "empty") istringstream ( tempinput ) >> tempviscosity_flag;
     parameter_list.viscosity_flag = tempviscosity_flag;
 
     // Include_Shear_Visc_Yes_1_No_0
     int tempturn_on_shear = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Shear_Visc_Yes_1_No_0");
+    tempinput = input_parameters.find("Include_Shear_Visc_Yes_1_No_0");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempturn_on_shear;
     parameter_list.turn_on_shear = tempturn_on_shear;
@@ -524,14 +667,14 @@ InitData read_in_parameters(std::string input_file) {
     // if 1, ignore constant eta/s
     // and use hard-coded T-dependent shear viscosity
     int tempT_dependent_shear_to_s = 0;
-    tempinput = Util::StringFind4(input_file, "T_dependent_Shear_to_S_ratio");
+    tempinput = input_parameters.find("T_dependent_Shear_to_S_ratio");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempT_dependent_shear_to_s;
     parameter_list.T_dependent_shear_to_s = tempT_dependent_shear_to_s;
 
     //Shear_to_S_ratio:  constant eta/s
     double tempshear_to_s = 0.08;
-    tempinput = Util::StringFind4(input_file, "Shear_to_S_ratio");
+    tempinput = input_parameters.find("Shear_to_S_ratio");
     if (tempinput != "empty") {
         istringstream(tempinput) >> tempshear_to_s;
     } else if (parameter_list.turn_on_shear == 1
@@ -545,19 +688,19 @@ InitData read_in_parameters(std::string input_file) {
     // (eta/s)(T) = eta_over_s_min + eta_over_s_slope*(T − Tc)*(T/Tc)^{eta_over_s_curv}
     // with T_c=0.154 GeV
     double temp_eta_over_s_min = 0.08;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_min");
+    tempinput = input_parameters.find("eta_over_s_min");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_min;
     parameter_list.eta_over_s_min = temp_eta_over_s_min;
 
     double temp_eta_over_s_slope = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_slope");
+    tempinput = input_parameters.find("eta_over_s_slope");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_slope;
     parameter_list.eta_over_s_slope = temp_eta_over_s_slope;
 
     double temp_eta_over_s_curv = 0;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_curv");
+    tempinput = input_parameters.find("eta_over_s_curv");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_curv;
     parameter_list.eta_over_s_curv = temp_eta_over_s_curv;
@@ -565,42 +708,41 @@ InitData read_in_parameters(std::string input_file) {
 
     // If "T_dependent_Shear_to_S_ratio==3", 
     double temp_eta_over_s_T_kink_in_GeV = .16;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_T_kink_in_GeV");
+    tempinput = input_parameters.find("eta_over_s_T_kink_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_T_kink_in_GeV;
     parameter_list.eta_over_s_T_kink_in_GeV = temp_eta_over_s_T_kink_in_GeV;
 
     double temp_eta_over_s_low_T_slope_in_GeV = 0.0;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_low_T_slope_in_GeV");
+    tempinput = input_parameters.find("eta_over_s_low_T_slope_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_low_T_slope_in_GeV;
     parameter_list.eta_over_s_low_T_slope_in_GeV = (
                                         temp_eta_over_s_low_T_slope_in_GeV);
 
     double temp_eta_over_s_high_T_slope_in_GeV = 0.0;
-    tempinput = Util::StringFind4(input_file,
-                                  "eta_over_s_high_T_slope_in_GeV");
+    tempinput = input_parameters.find("eta_over_s_high_T_slope_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_high_T_slope_in_GeV;
     parameter_list.eta_over_s_high_T_slope_in_GeV = (
                                     temp_eta_over_s_high_T_slope_in_GeV);
 
     double temp_eta_over_s_at_kink = 0.08;
-    tempinput = Util::StringFind4(input_file, "eta_over_s_at_kink");
+    tempinput = input_parameters.find("eta_over_s_at_kink");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> temp_eta_over_s_at_kink;
     parameter_list.eta_over_s_at_kink = temp_eta_over_s_at_kink;
 
     // Include_Bulk_Visc_Yes_1_No_0
     int tempturn_on_bulk = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Bulk_Visc_Yes_1_No_0");
+    tempinput = input_parameters.find("Include_Bulk_Visc_Yes_1_No_0");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempturn_on_bulk;
     parameter_list.turn_on_bulk = tempturn_on_bulk;
 
     // T_dependent_Bulk_to_S_ratio:
     int tempT_dependent_bulk_to_s = 1;
-    tempinput = Util::StringFind4(input_file, "T_dependent_Bulk_to_S_ratio");
+    tempinput = input_parameters.find("T_dependent_Bulk_to_S_ratio");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempT_dependent_bulk_to_s;
     parameter_list.T_dependent_bulk_to_s = tempT_dependent_bulk_to_s;
@@ -608,76 +750,87 @@ InitData read_in_parameters(std::string input_file) {
     // "T_dependent_Bulk_to_S_ratio=2", 
     // bulk viscosity is parametrized as with "A", "G" and "Tc" as "A*(1/(1+((T-Tc)/G)^2)"
     double tempBulkViscosityNorm = 0.33;
-    tempinput = Util::StringFind4(input_file, "bulk_viscosity_normalisation");
+    tempinput = input_parameters.find("bulk_viscosity_normalisation");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempBulkViscosityNorm;
     parameter_list.bulk_viscosity_normalisation = tempBulkViscosityNorm;
 
     double tempBulkViscosityWidth = 0.08;
-    tempinput = Util::StringFind4(input_file, "bulk_viscosity_width_in_GeV");
+    tempinput = input_parameters.find("bulk_viscosity_width_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempBulkViscosityWidth;
     parameter_list.bulk_viscosity_width_in_GeV = tempBulkViscosityWidth;
 
     double tempBulkViscosityPeak = 0.18;
-    tempinput = Util::StringFind4(input_file, "bulk_viscosity_peak_in_GeV");
+    tempinput = input_parameters.find("bulk_viscosity_peak_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempBulkViscosityPeak;
     parameter_list.bulk_viscosity_peak_in_GeV = tempBulkViscosityPeak;
 
     // "T_dependent_Bulk_to_S_ratio==3",
     double tempzeta_over_s_max= 0.1;
-    tempinput = Util::StringFind4(input_file, "zeta_over_s_max");
+    tempinput = input_parameters.find("zeta_over_s_max");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempzeta_over_s_max;
     parameter_list.zeta_over_s_max = tempzeta_over_s_max;
 
     double tempzeta_over_s_width_in_GeV= 0.05;
-    tempinput = Util::StringFind4(input_file, "zeta_over_s_width_in_GeV");
+    tempinput = input_parameters.find("zeta_over_s_width_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempzeta_over_s_width_in_GeV;
     parameter_list.zeta_over_s_width_in_GeV = tempzeta_over_s_width_in_GeV;
 
     double tempzeta_over_s_T_peak_in_GeV= 0.18;
-    tempinput = Util::StringFind4(input_file, "zeta_over_s_T_peak_in_GeV");
+    tempinput = input_parameters.find("zeta_over_s_T_peak_in_GeV");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempzeta_over_s_T_peak_in_GeV;
     parameter_list.zeta_over_s_T_peak_in_GeV = tempzeta_over_s_T_peak_in_GeV;
 
     double tempzeta_over_s_lambda_asymm= 0.;
-    tempinput = Util::StringFind4(input_file, "zeta_over_s_lambda_asymm");
+    tempinput = input_parameters.find("zeta_over_s_lambda_asymm");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempzeta_over_s_lambda_asymm;
     parameter_list.zeta_over_s_lambda_asymm = tempzeta_over_s_lambda_asymm;
     // Include secord order terms
     int tempturn_on_second_order = 0;
-    tempinput = Util::StringFind4(input_file, "Include_second_order_terms");
+    tempinput = input_parameters.find("Include_second_order_terms");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempturn_on_second_order;
     parameter_list.include_second_order_terms = tempturn_on_second_order;
 
     int tempturn_on_diff = 0;
-    tempinput = Util::StringFind4(input_file, "turn_on_baryon_diffusion");
+    tempinput = input_parameters.find("turn_on_baryon_diffusion");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempturn_on_diff;
     parameter_list.turn_on_diff = tempturn_on_diff;
 
     // Relaxation time factors
     double tempshear_relax_time_factor= 5.;
-    tempinput = Util::StringFind4(input_file, "shear_relax_time_factor");
+    tempinput = input_parameters.find("shear_relax_time_factor");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempshear_relax_time_factor;
     parameter_list.shear_relax_time_factor = tempshear_relax_time_factor;
 
     double tempbulk_relax_time_factor= 1./14.55;
-    tempinput = Util::StringFind4(input_file, "bulk_relax_time_factor");
+    tempinput = input_parameters.find("bulk_relax_time_factor");
     if (tempinput != "empty")
         istringstream ( tempinput ) >> tempbulk_relax_time_factor;
     parameter_list.bulk_relax_time_factor = tempbulk_relax_time_factor;
 
+    // transport_coeffs_table:
+    // 0: evaluate the T-dependent eta/s and zeta/s parametrizations
+    //    in every cell
+    // 1: tabulate them once on a fine grid in T (0.05 MeV) and
+    //    interpolate linearly
+    int temp_transport_coeffs_table = 0;
+    tempinput = input_parameters.find("transport_coeffs_table");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_transport_coeffs_table;
+    parameter_list.transport_coeffs_table = temp_transport_coeffs_table;
+
     // kappa coefficient
     double temp_kappa_coefficient = 0.0;
-    tempinput = Util::StringFind4(input_file, "kappa_coefficient");
+    tempinput = input_parameters.find("kappa_coefficient");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_kappa_coefficient;
     parameter_list.kappa_coefficient = temp_kappa_coefficient;
@@ -686,25 +839,25 @@ InitData read_in_parameters(std::string input_file) {
     // Looks like 0 sets delta_f=0, 1 uses standard quadratic ansatz,
     // and 2 is supposed to use p^(2-alpha)
     int tempinclude_deltaf = 1;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf");
+    tempinput = input_parameters.find("Include_deltaf");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempinclude_deltaf;
     parameter_list.include_deltaf = tempinclude_deltaf;
 
     int tempinclude_deltaf_bulk = 0;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf_bulk");
+    tempinput = input_parameters.find("Include_deltaf_bulk");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempinclude_deltaf_bulk;
     parameter_list.include_deltaf_bulk = tempinclude_deltaf_bulk;
 
     int tempinclude_deltaf_qmu = 0;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf_qmu");
+    tempinput = input_parameters.find("Include_deltaf_qmu");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempinclude_deltaf_qmu;
     parameter_list.include_deltaf_qmu = tempinclude_deltaf_qmu;
 
     int temp_deltaf_14moments = 0;
-    tempinput = Util::StringFind4(input_file, "deltaf_14moments");
+    tempinput = input_parameters.find("deltaf_14moments");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_deltaf_14moments;
     parameter_list.deltaf_14moments = temp_deltaf_14moments;
@@ -712,87 +865,110 @@ InitData read_in_parameters(std::string input_file) {
     // Do_FreezeOut_Yes_1_No_0
     // set to 0 to bypass freeze out surface finder
     int tempdoFreezeOut = 1;
-    tempinput = Util::StringFind4(input_file, "Do_FreezeOut_Yes_1_No_0");
+    tempinput = input_parameters.find("Do_FreezeOut_Yes_1_No_0");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempdoFreezeOut;
     parameter_list.doFreezeOut = tempdoFreezeOut;
 
     int tempdoFreezeOut_lowtemp = 1;
-    tempinput = Util::StringFind4(input_file, "Do_FreezeOut_lowtemp");
+    tempinput = input_parameters.find("Do_FreezeOut_lowtemp");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempdoFreezeOut_lowtemp;
     parameter_list.doFreezeOut_lowtemp = tempdoFreezeOut_lowtemp;
 
     // Initial_Distribution_input_filename
     string tempinitName = "initial/initial_ed.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Distribution_input_filename");
+    tempinput = input_parameters.find("Initial_Distribution_input_filename");
     if (tempinput != "empty")
         tempinitName.assign(tempinput);
     parameter_list.initName.assign(tempinitName);
 
     // Initial_Distribution_Filename for rhob
     string tempinitName_rhob = "initial/initial_rhob.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Rhob_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_Rhob_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_rhob.assign(tempinput);
     parameter_list.initName_rhob.assign(tempinitName_rhob);
 
     // Initial_Distribution_Filename for ux
     string tempinitName_ux = "initial/initial_ux.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_ux_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_ux_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_ux.assign(tempinput);
     parameter_list.initName_ux.assign(tempinitName_ux);
     // Initial_Distribution_Filename for uy
     string tempinitName_uy = "initial/initial_uy.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_uy_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_uy_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_uy.assign(tempinput);
     parameter_list.initName_uy.assign(tempinitName_uy);
     // Initial_Distribution_Filename for TA
     string tempinitName_TA = "initial/initial_TA.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_TA_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_TA_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_TA.assign(tempinput);
     parameter_list.initName_TA.assign(tempinitName_TA);
     // Initial_Distribution_Filename for TB
     string tempinitName_TB = "initial/initial_TB.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_TB_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_TB_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_TB.assign(tempinput);
     parameter_list.initName_TB.assign(tempinitName_TB);
     // Initial_Distribution_Filename for rhob TA
     string tempinitName_rhob_TA = "initial/initial_rhob_TA.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_rhob_TA_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_rhob_TA_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_rhob_TA.assign(tempinput);
     parameter_list.initName_rhob_TA.assign(tempinitName_rhob_TA);
     // Initial_Distribution_Filename for rhob TB
     string tempinitName_rhob_TB = "initial/initial_TB.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_rhob_TB_Distribution_Filename");
+    tempinput = input_parameters.find("Initial_rhob_TB_Distribution_Filename");
     if (tempinput != "empty")
         tempinitName_rhob_TB.assign(tempinput);
     parameter_list.initName_rhob_TB.assign(tempinitName_rhob_TB);
 
     // Initial_Distribution_AMPT_filename for AMPT
     string tempinitName_AMPT = "initial/initial_AMPT.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Distribution_AMPT_filename");
+    tempinput = input_parameters.find("Initial_Distribution_AMPT_filename");
     if (tempinput != "empty")
         tempinitName_AMPT.assign(tempinput);
     parameter_list.initName_AMPT.assign(tempinitName_AMPT);
 
+    // initial_condition_binary_precision:
+    // bytes per value of the binary initial conditions written in mode 74
+    // 4: float
+    // 8: double
+    int temp_initial_condition_binary_precision = 8;
+    tempinput = input_parameters.find("initial_condition_binary_precision");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_initial_condition_binary_precision;
+    parameter_list.initial_condition_binary_precision =
+                                    temp_initial_condition_binary_precision;
+
+    // ensemble_event_list:
+    // a file listing one initial-condition file per line. Every file is
+    // evolved as its own event in the directory event_<n>, it replaces
+    // Initial_Distribution_input_filename (Initial_TA_Distribution_Filename
+    // for Initial_profile 11)
+    string temp_ensemble_event_list = "";
+    tempinput = input_parameters.find("ensemble_event_list");
+    if (tempinput != "empty")
+        temp_ensemble_event_list.assign(tempinput);
+    parameter_list.ensemble_event_list.assign(temp_ensemble_event_list);
+
+    // ensemble_concurrent_events:
+    // number of ensemble events evolved at the same time
+    int temp_ensemble_concurrent_events = 1;
+    tempinput = input_parameters.find("ensemble_concurrent_events");
+    if (tempinput != "empty")
+        istringstream(tempinput) >> temp_ensemble_concurrent_events;
+    parameter_list.ensemble_concurrent_events =
+                                        temp_ensemble_concurrent_events;
+    parameter_list.output_directory = "";
+
     // compute beam rapidity according to the collision energy
     double temp_ecm = 200;
-    tempinput = Util::StringFind4(input_file, "ecm");
+    tempinput = input_parameters.find("ecm");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_ecm;
     parameter_list.ecm = temp_ecm;
@@ -800,7 +976,7 @@ InitData read_in_parameters(std::string input_file) {
     parameter_list.beam_rapidity = y_beam;
 
     int tempoutputBinaryEvolution = 0;
-    tempinput = Util::StringFind4(input_file, "outputBinaryEvolution");
+    tempinput = input_parameters.find("outputBinaryEvolution");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempoutputBinaryEvolution;
     parameter_list.outputBinaryEvolution = tempoutputBinaryEvolution;
@@ -808,7 +984,7 @@ InitData read_in_parameters(std::string input_file) {
     //  Make MUSIC output additionnal hydro information
     //  0 for false (do not output), 1 for true
     int tempoutput_hydro_debug_info = 0;
-    tempinput = Util::StringFind4(input_file, "output_hydro_debug_info");
+    tempinput = input_parameters.find("output_hydro_debug_info");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempoutput_hydro_debug_info;
     parameter_list.output_hydro_debug_info = tempoutput_hydro_debug_info;
@@ -816,29 +992,28 @@ InitData read_in_parameters(std::string input_file) {
     // The evolution is outputted every
     // "output_evolution_every_N_timesteps" timesteps
     int temp_evo_N_tau = 1;
-    tempinput = Util::StringFind4(input_file,
-                                  "output_evolution_every_N_timesteps");
+    tempinput = input_parameters.find("output_evolution_every_N_timesteps");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_evo_N_tau;
     parameter_list.output_evolution_every_N_timesteps = temp_evo_N_tau;
 
     int temp_evo_N_x = 1;
-    tempinput = Util::StringFind4(input_file, "output_evolution_every_N_x");
+    tempinput = input_parameters.find("output_evolution_every_N_x");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_evo_N_x;
     parameter_list.output_evolution_every_N_x = temp_evo_N_x;
 
     int temp_evo_N_y = 1;
-    tempinput = Util::StringFind4(input_file, "output_evolution_every_N_y");
+    tempinput = input_parameters.find("output_evolution_every_N_y");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_evo_N_y;
     parameter_list.output_evolution_every_N_y = temp_evo_N_y;
 
     int temp_evo_N_eta = 1;
-    tempinput = Util::StringFind4(input_file, "output_evolution_every_N_eta");
+    tempinput = input_parameters.find("output_evolution_every_N_eta");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_evo_N_eta;
     parameter_list.output_evolution_every_N_eta = temp_evo_N_eta;
 
     double temp_evo_T_cut = 0.130;  // GeV
-    tempinput = Util::StringFind4(input_file, "output_evolution_T_cut");
+    tempinput = input_parameters.find("output_evolution_T_cut");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_evo_T_cut;
     parameter_list.output_evolution_T_cut = temp_evo_T_cut;
@@ -847,64 +1022,80 @@ InitData read_in_parameters(std::string input_file) {
     // informations about the hydro parameters used
     // 0 for false (do not output), 1 for true
     bool tempoutput_hydro_params_header = false;
-    tempinput = Util::StringFind4(input_file, "output_hydro_params_header");
+    tempinput = input_parameters.find("output_hydro_params_header");
     if (tempinput != "empty")
         istringstream(tempinput) >> tempoutput_hydro_params_header;
     parameter_list.output_hydro_params_header = tempoutput_hydro_params_header;
 
     // initial parameters for mode 14
     double temp_dNdy_y_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdy_y_min");
+    tempinput = input_parameters.find("dNdy_y_min");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_y_min;
     parameter_list.dNdy_y_min = temp_dNdy_y_min;
 
     double temp_dNdy_y_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdy_y_max");
+    tempinput = input_parameters.find("dNdy_y_max");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_y_max;
     parameter_list.dNdy_y_max = temp_dNdy_y_max;
 
     double temp_dNdy_eta_min = -2.0;
-    tempinput = Util::StringFind4(input_file, "dNdy_eta_min");
+    tempinput = input_parameters.find("dNdy_eta_min");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_eta_min;
     parameter_list.dNdy_eta_min = temp_dNdy_eta_min;
 
     double temp_dNdy_eta_max = 2.0;
-    tempinput = Util::StringFind4(input_file, "dNdy_eta_max");
+    tempinput = input_parameters.find("dNdy_eta_max");
     if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_eta_max;
     parameter_list.dNdy_eta_max = temp_dNdy_eta_max;
 
     int temp_dNdy_nrap = 30;
-    tempinput = Util::StringFind4(input_file, "dNdy_nrap");
+    tempinput = input_parameters.find("dNdy_nrap");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_dNdy_nrap;
     parameter_list.dNdy_nrap = temp_dNdy_nrap;
 
     double temp_dNdyptdpt_y_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_y_min");
+    tempinput = input_parameters.find("dNdyptdpt_y_min");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_dNdyptdpt_y_min;
     parameter_list.dNdyptdpt_y_min = temp_dNdyptdpt_y_min;
 
     double temp_dNdyptdpt_y_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_y_max");
+    tempinput = input_parameters.find("dNdyptdpt_y_max");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_dNdyptdpt_y_max;
     parameter_list.dNdyptdpt_y_max = temp_dNdyptdpt_y_max;
 
     double temp_dNdyptdpt_eta_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_eta_min");
+    tempinput = input_parameters.find("dNdyptdpt_eta_min");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_dNdyptdpt_eta_min;
     parameter_list.dNdyptdpt_eta_min = temp_dNdyptdpt_eta_min;
 
     double temp_dNdyptdpt_eta_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_eta_max");
+    tempinput = input_parameters.find("dNdyptdpt_eta_max");
     if (tempinput != "empty")
         istringstream(tempinput) >> temp_dNdyptdpt_eta_max;
     parameter_list.dNdyptdpt_eta_max = temp_dNdyptdpt_eta_max;
 
     music_message.info("Done read_in_parameters.");
-    check_parameters(parameter_list, input_file);
+    check_parameters(parameter_list, input_parameters);
+
+    // the parameters that are only read for some settings
+    input_parameters.mark_known({"T_freeze", "epsilon_freeze", "N_freeze_out",
+                                 "reset_dtau_use_CFL_condition"});
+    for (const auto &name : input_parameters.get_repeated_names()) {
+        music_message << "The parameter " << name << " is set more than once "
+                      << "in " << input_file << ", the first value is used.";
+        music_message.flush("warning");
+    }
+    const auto unknown_names = input_parameters.get_unknown_names();
+    if (!unknown_names.empty()) {
+        music_message << "Unknown parameters in " << input_file
+                      << " are ignored:";
+        for (const auto &name : unknown_names) music_message << " " << name;
+        music_message.flush("warning");
+    }
 
     return parameter_list;
 }
@@ -915,6 +1106,13 @@ void set_parameter(InitData &parameter_list, std::string parameter_name,
     if (parameter_name == "MUSIC_mode")
         parameter_list.mode = static_cast<int>(value);
 
+    if (parameter_name == "ensemble_concurrent_events")
+        parameter_list.ensemble_concurrent_events = static_cast<int>(value);
+
+    if (parameter_name == "initial_condition_binary_precision")
+        parameter_list.initial_condition_binary_precision =
+                                                    static_cast<int>(value);
+
     if (parameter_name == "Initial_time_tau_0")
         parameter_list.tau0 = value;
 
@@ -926,10 +1124,24 @@ void set_parameter(InitData &parameter_list, std::string parameter_name,
 
     if (parameter_name == "store_hydro_info_in_memory")
         parameter_list.store_hydro_info_in_memory = static_cast<int>(value);
+    if (parameter_name == "store_hydro_info_precision")
+        parameter_list.store_hydro_info_precision = static_cast<int>(value);
 
     if (parameter_name == "Viscosity_Flag_Yes_1_No_0")
         parameter_list.viscosity_flag = static_cast<int>(value);
 
+    if (parameter_name == "flux_sweep_mode")
+        parameter_list.flux_sweep_mode = static_cast<int>(value);
+
+    if (parameter_name == "temporal_blocking_slab")
+        parameter_list.temporal_blocking_slab = static_cast<int>(value);
+
+    if (parameter_name == "omp_thread_binding")
+        parameter_list.omp_thread_binding = static_cast<int>(value);
+
+    if (parameter_name == "reconst_initial_guess")
+        parameter_list.reconst_initial_guess = static_cast<int>(value);
+
     if (parameter_name == "Include_Shear_Visc_Yes_1_No_0")
         parameter_list.turn_on_shear = static_cast<int>(value);
 
@@ -982,9 +1194,13 @@ void set_parameter(InitData &parameter_list, std::string parameter_name,
         parameter_list.zeta_over_s_T_peak_in_GeV = value;
     if (parameter_name == "zeta_over_s_lambda_asymm")
         parameter_list.zeta_over_s_lambda_asymm = value;
+
+    if (parameter_name == "transport_coeffs_table")
+        parameter_list.transport_coeffs_table = static_cast<int>(value);
 }
 
-void check_parameters(InitData &parameter_list, std::string input_file) {
+void check_parameters(InitData &parameter_list,
+                      ParameterTable &input_parameters) {
     music_message.info("Checking input parameter list ... ");
 
     if (parameter_list.Initial_profile < 0) {
@@ -1039,6 +1255,85 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         exit(1);
     }
 
+    if (parameter_list.eos_interpolation_order != 1
+            && parameter_list.eos_interpolation_order != 3) {
+        music_message << "Invalid option for EOS_interpolation_order: "
+                      << parameter_list.eos_interpolation_order;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.eos_derivative_tables != 0
+            && parameter_list.eos_derivative_tables != 1) {
+        music_message << "Invalid option for EOS_derivative_tables: "
+                      << parameter_list.eos_derivative_tables;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.eos_resample_tolerance > 0.
+            && parameter_list.eos_interpolation_order != 3) {
+        music_message << "EOS_resample_tolerance > 0 requires "
+                      << "EOS_interpolation_order = 3";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.ensemble_event_list != "") {
+        const int profile = parameter_list.Initial_profile;
+        if (parameter_list.mode != 2
+                || (profile != 8 && profile != 9 && profile != 91
+                    && profile != 92 && profile != 11 && profile != 101)) {
+            music_message << "ensemble_event_list needs mode 2 and an "
+                          << "Initial_profile read from a file "
+                          << "(8, 9, 91, 92, 11 or 101)";
+            music_message.flush("error");
+            exit(1);
+        }
+        // an event of the MC-Glauber model has four text profiles, but the
+        // list gives one file per event
+        if (profile == 11) {
+            for (const auto &file_name: read_ensemble_event_list(
+                                    parameter_list.ensemble_event_list)) {
+                if (!InitialConditionFile::is_container(file_name)) {
+                    music_message << "ensemble_event_list with "
+                                  << "Initial_profile 11 needs initial-"
+                                  << "condition containers with TA, TB, "
+                                  << "rhob_TA and rhob_TB, " << file_name
+                                  << " is not one (see mode 74)";
+                    music_message.flush("error");
+                    exit(1);
+                }
+            }
+        }
+    }
+
+    if (parameter_list.ensemble_concurrent_events < 1) {
+        music_message << "Invalid option for ensemble_concurrent_events: "
+                      << parameter_list.ensemble_concurrent_events;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.initial_condition_binary_precision != 4
+            && parameter_list.initial_condition_binary_precision != 8) {
+        music_message << "Invalid option for "
+                      << "initial_condition_binary_precision: "
+                      << parameter_list.initial_condition_binary_precision
+                      << ", it must be 4 or 8";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.store_hydro_info_precision != 2
+            && parameter_list.store_hydro_info_precision != 4) {
+        music_message << "Invalid option for store_hydro_info_precision: "
+                      << parameter_list.store_hydro_info_precision
+                      << ", it must be 2 or 4";
+        music_message.flush("error");
+        exit(1);
+    }
+
     if (parameter_list.whichEOS > 1 && parameter_list.whichEOS < 7
             && parameter_list.NumberOfParticlesToInclude > 320) {
         music_message << "Invalid option for number_of_particles_to_include:"
@@ -1121,8 +1416,8 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
 
         bool reset_dtau_use_CFL_condition = true;
         int temp_CFL_condition = 1;
-        string tempinput = Util::StringFind4(input_file,
-                                      "reset_dtau_use_CFL_condition");
+        string tempinput = input_parameters.find(
+                                   "reset_dtau_use_CFL_condition");
         if (tempinput != "empty")
             istringstream(tempinput) >> temp_CFL_condition;
         if (temp_CFL_condition == 0)
@@ -1163,12 +1458,59 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         exit(1);
     }
 
-    if (parameter_list.rk_order > 2 || parameter_list.rk_order < 0) {
+    if (parameter_list.rk_order > 3 || parameter_list.rk_order < 1) {
         music_message << "Invalid option for Runge_Kutta_order: "
                       << parameter_list.rk_order;
         music_message.flush("error");
         exit(1);
     }
+    if (parameter_list.flux_sweep_mode != 0
+            && parameter_list.flux_sweep_mode != 1) {
+        music_message << "Invalid option for flux_sweep_mode: "
+                      << parameter_list.flux_sweep_mode;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.temporal_blocking_slab < 0) {
+        music_message << "Invalid option for temporal_blocking_slab: "
+                      << parameter_list.temporal_blocking_slab;
+        music_message.flush("error");
+        exit(1);
+    }
+    if (parameter_list.temporal_blocking_slab > 0
+            && parameter_list.flux_sweep_mode == 1) {
+        music_message << "temporal_blocking_slab > 0 needs "
+                      << "flux_sweep_mode = 0, because the face fluxes "
+                      << "are stored for one stage at a time";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.omp_thread_binding != 0
+            && parameter_list.omp_thread_binding != 1) {
+        music_message << "Invalid option for omp_thread_binding: "
+                      << parameter_list.omp_thread_binding;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.reconst_initial_guess < 0
+            || parameter_list.reconst_initial_guess > 2) {
+        music_message << "Invalid option for reconst_initial_guess: "
+                      << parameter_list.reconst_initial_guess;
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.transport_coeffs_table != 0
+            && parameter_list.transport_coeffs_table != 1) {
+        music_message << "Invalid option for transport_coeffs_table: "
+                      << parameter_list.transport_coeffs_table;
+        music_message.flush("error");
+        exit(1);
+    }
+
     if (parameter_list.rk_order != 2) {
         music_message << "Runge-Kutta order = " << parameter_list.rk_order;
         music_message.flush("info");
@@ -1276,4 +1618,59 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
     music_message.flush("info");
 }
 
+
+std::vector<std::string> read_ensemble_event_list(
+                                        const std::string &list_file) {
+    std::ifstream event_list(list_file.c_str());
+    if (!event_list.good()) {
+        music_message << "read_ensemble_event_list: can not open "
+                      << list_file;
+        music_message.flush("error");
+        exit(1);
+    }
+    std::vector<std::string> event_files;
+    std::string line;
+    while (std::getline(event_list, line)) {
+        std::istringstream line_stream(line);
+        std::string file_name;
+        if (line_stream >> file_name && file_name[0] != '#') {
+            event_files.push_back(file_name);
+        }
+    }
+    return(event_files);
+}
+
+}
+
+
+TEST_CASE("check the parameter table") {
+    const std::string file_name = "test_parameter_table.dat";
+    std::ofstream input_file(file_name.c_str());
+    input_file << "# a comment line" << std::endl
+               << "echo_level  1   # with a comment" << std::endl
+               << std::endl
+               << "Initial_profile 9" << std::endl
+               << "Initial_profile 8" << std::endl
+               << "unknown_parameter 3" << std::endl
+               << "EndOfData" << std::endl
+               << "Delta_Tau 0.1" << std::endl;
+    input_file.close();
+
+    ReadInParameters::ParameterTable input_parameters(file_name);
+    CHECK(input_parameters.find("echo_level") == "1");
+    CHECK(input_parameters.find("Initial_profile") == "9");
+    CHECK(input_parameters.find("Delta_Tau") == "empty");
+    CHECK(input_parameters.find("Initial_profile")
+          == Util::StringFind4(file_name, "Initial_profile"));
+
+    auto unknown = input_parameters.get_unknown_names();
+    REQUIRE(unknown.size() == 1);
+    CHECK(unknown[0] == "unknown_parameter");
+    input_parameters.mark_known({"unknown_parameter"});
+    CHECK(input_parameters.get_unknown_names().empty());
+
+    auto repeated = input_parameters.get_repeated_names();
+    REQUIRE(repeated.size() == 1);
+    CHECK(repeated[0] == "Initial_profile");
+    std::remove(file_name.c_str());
 }
@@ -2,6 +2,9 @@
 #define SRC_READ_IN_PARAMETERS_H_
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "data.h"
 #include "util.h"
@@ -10,10 +13,33 @@
 
 //! This class handles read in parameters
 namespace ReadInParameters {
+    //! The parameters of an input file, read once. find returns the value
+    //! of the first occurrence of a parameter, or "empty", like
+    //! Util::StringFind4, and remembers which parameters were looked up
+    class ParameterTable {
+     private:
+        std::vector<std::string> names_;
+        std::unordered_map<std::string, std::string> values_;
+        std::unordered_set<std::string> known_;
+
+     public:
+        explicit ParameterTable(std::string input_file);
+        std::string find(const std::string &name);
+        void mark_known(const std::vector<std::string> &names);
+        std::vector<std::string> get_unknown_names() const;
+        std::vector<std::string> get_repeated_names() const;
+    };
+
     InitData read_in_parameters(std::string input_file);
-    void check_parameters(InitData &parameter_list, std::string input_file);
+    void check_parameters(InitData &parameter_list,
+                          ParameterTable &input_parameters);
     void set_parameter(InitData &parameter_list, std::string parameter_name,
                        double value);
+    //! returns the initial-condition files of an ensemble event list, the
+    //! first word of every line; empty lines and lines starting with #
+    //! are skipped
+    std::vector<std::string> read_ensemble_event_list(
+                                        const std::string &list_file);
 }
 
 #endif  // SRC_READ_IN_PARAMETERS_H_
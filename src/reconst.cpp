@@ -1,7 +1,15 @@
 // Copyright 2011 @ Bjoern Schenke, Sangyong Jeon, and Charles Gale
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <random>
+#include <vector>
+#include "doctest.h"
 #include "data.h"
 #include "cell.h"
 #include "grid.h"
@@ -18,11 +26,134 @@ Reconst::Reconst(const EOS &eosIn, const InitData &DATA_in) :
     v_critical(0.563624) {
     eos_eps_max = eos.get_eps_max();
     echo_level = DATA.echo_level;
+    initial_guess_mode = DATA.reconst_initial_guess;
+    collect_statistics = (echo_level > 5);
+    prepare_statistics();
+    if (initial_guess_mode == 2) {
+        build_v_guess_table();
+        reset_statistics();
+    }
+}
+
+
+//! returns the counters of the calling thread, or nullptr if no counters
+//! are kept. A thread without counters (the team is larger than at the
+//! last prepare_statistics) is not counted
+ReconstStats* Reconst::local_stats() {
+    if (!collect_statistics) return(nullptr);
+    int i_thread = 0;
+#ifdef _OPENMP
+    i_thread = omp_get_thread_num();
+#endif
+    if (i_thread >= static_cast<int>(thread_stats.size())) return(nullptr);
+    return(&thread_stats[i_thread].stats);
+}
+
+
+void Reconst::prepare_statistics() {
+    if (!collect_statistics) return;
+    unsigned int n_threads = 1;
+#ifdef _OPENMP
+    n_threads = omp_get_max_threads();
+#endif
+    if (thread_stats.size() < n_threads) thread_stats.resize(n_threads);
+}
+
+
+ReconstStats Reconst::get_statistics() const {
+    ReconstStats total;
+    for (const auto &thread_i : thread_stats) {
+        total.n_cells      += thread_i.stats.n_cells;
+        total.n_iterations += thread_i.stats.n_iterations;
+        total.n_failures   += thread_i.stats.n_failures;
+    }
+    return(total);
+}
+
+
+void Reconst::reset_statistics() {
+    for (auto &thread_i : thread_stats) {
+        thread_i.stats = ReconstStats();
+    }
+}
+
+
+//! This function tabulates the solution of the velocity Newton iterations
+//! at J0 = 0 as a function of log(T00) and M/T00, which is used as the
+//! initial guess for initial_guess_mode = 2
+void Reconst::build_v_guess_table() {
+    n_guess_T00 = 241;
+    n_guess_M   = 401;
+    guess_log_T00_min = log(1e-5);
+    guess_dlog_T00 = (log(std::max(eos_eps_max, 1e-4))
+                      - guess_log_T00_min)/(n_guess_T00 - 1);
+    guess_dM = 1./(n_guess_M - 1);
+    v_guess_table.resize(n_guess_T00*n_guess_M);
+
+    const int echo_level_saved = echo_level;
+    echo_level = 0;  // failed nodes fall back to v = M/T00
+    for (int i = 0; i < n_guess_T00; i++) {
+        const double T00 = exp(guess_log_T00_min + i*guess_dlog_T00);
+        for (int j = 0; j < n_guess_M; j++) {
+            const double M = std::min(j*guess_dM, 0.999)*T00;
+            double v = M/T00;
+            double v_solution = v;
+            int status = 0;
+            switch (eos.get_eos_type()) {
+                case EOSType::ideal_gas:
+                    status = solve_velocity_Newton(
+                        eos.get_eos_impl<EOS_idealgas>(), v, T00, M, 0.,
+                        v_solution);
+                    break;
+                case EOSType::single_table:
+                    status = solve_velocity_Newton(
+                        eos.get_eos_impl<EOS_hotQCD>(), v, T00, M, 0.,
+                        v_solution);
+                    break;
+                case EOSType::multi_table:
+                    status = solve_velocity_Newton(
+                        eos.get_eos_impl<EOS_neos>(), v, T00, M, 0.,
+                        v_solution);
+                    break;
+                default:
+                    status = solve_velocity_Newton(
+                        eos.get_eos_impl<EOS_base>(), v, T00, M, 0.,
+                        v_solution);
+            }
+            v_guess_table[i*n_guess_M + j] = (status == 1) ? v_solution : v;
+        }
+    }
+    echo_level = echo_level_saved;
+}
+
+
+//! returns the initial guess of the velocity Newton iterations
+double Reconst::get_v_guess(const double T00, const double M,
+                            const double u0_guess) const {
+    if (initial_guess_mode == 2) {
+        double x_T = (log(std::max(T00, 1e-300)) - guess_log_T00_min)
+                     /guess_dlog_T00;
+        x_T = std::max(0., std::min(n_guess_T00 - 1.000001, x_T));
+        double x_M = std::max(0., std::min(1. - 1e-6, M/T00))/guess_dM;
+        const int i = static_cast<int>(x_T);
+        const int j = static_cast<int>(x_M);
+        x_T -= i;
+        x_M -= j;
+        const double *v_tb = &v_guess_table[i*n_guess_M + j];
+        return((1. - x_T)*((1. - x_M)*v_tb[0] + x_M*v_tb[1])
+               + x_T*((1. - x_M)*v_tb[n_guess_M] + x_M*v_tb[n_guess_M + 1]));
+    }
+    double v_guess = sqrt(1. - 1./(u0_guess*u0_guess + 1e-15));
+    if (v_guess != v_guess) {
+        v_guess = 0.0;
+    }
+    return(v_guess);
 }
 
 
 ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                     const Cell_small &grid_pt) {
+                                     const Cell_small &grid_pt,
+                                     double u0_guess) {
     ReconstCell grid_p1;
 
     TJbVec q_vec;
@@ -30,9 +161,16 @@ ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
         q_vec[i] = tauq_vec[i]/tau;
     }
 
-    int flag = ReconstIt_velocity_Newton(grid_p1, tau, q_vec, grid_pt);
+    if (u0_guess < 1.) {
+        u0_guess = grid_pt.u[0];
+    }
+    int flag = ReconstIt_velocity_Newton(grid_p1, tau, q_vec, grid_pt,
+                                         u0_guess);
 
+    auto *stats = local_stats();
+    if (stats != nullptr) stats->n_cells++;
     if (flag == -1) {
+        if (stats != nullptr) stats->n_failures++;
         revert_grid(grid_p1, grid_pt);
     } else if (flag == -2) {
         regulate_grid(grid_p1, q_vec[0]);
@@ -42,6 +180,125 @@ ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
 }
 
 
+//! This function reconstructs n cells at once. It gives the same results
+//! as calling ReconstIt_shell for every cell; grid_pt[i] is the reference
+//! cell of the i-th one
+void Reconst::ReconstIt_shell(const double tau, const int n,
+                              const TJbVec *tauq_vec,
+                              const Cell_small * const *grid_pt,
+                              ReconstCell *grid_p) {
+    switch (eos.get_eos_type()) {
+        case EOSType::ideal_gas:
+            ReconstIt_velocity_Newton_batch(eos.get_eos_impl<EOS_idealgas>(),
+                                            tau, n, tauq_vec, grid_pt, grid_p);
+            break;
+        case EOSType::single_table:
+            ReconstIt_velocity_Newton_batch(eos.get_eos_impl<EOS_hotQCD>(),
+                                            tau, n, tauq_vec, grid_pt, grid_p);
+            break;
+        case EOSType::multi_table:
+            ReconstIt_velocity_Newton_batch(eos.get_eos_impl<EOS_neos>(),
+                                            tau, n, tauq_vec, grid_pt, grid_p);
+            break;
+        default:
+            ReconstIt_velocity_Newton_batch(eos.get_eos_impl<EOS_base>(),
+                                            tau, n, tauq_vec, grid_pt, grid_p);
+    }
+}
+
+
+//! This function solves the velocity Newton iterations for blocks of cells
+//! in lock-step. In every iteration the EoS is evaluated for all the
+//! unconverged cells of the block first, and then all of them are updated;
+//! converged cells are dropped from the block. The cells that need the
+//! u0 iterations (v > v_critical), that fail, or that are reverted or
+//! regulated go through the scalar ReconstIt_shell instead
+template <class EOS_t>
+void Reconst::ReconstIt_velocity_Newton_batch(
+        const EOS_t &eos_impl, const double tau, const int n,
+        const TJbVec *tauq_vec, const Cell_small * const *grid_pt,
+        ReconstCell *grid_p) {
+    const int block_size = 32;
+    TJbVec q[block_size];
+    double T00[block_size], K00[block_size], M[block_size], J0[block_size];
+    double v[block_size], fv[block_size], dfdv[block_size];
+    int iter[block_size];
+    int active[block_size];
+    bool use_scalar[block_size];
+
+    for (int i_start = 0; i_start < n; i_start += block_size) {
+        const int n_block = std::min(block_size, n - i_start);
+        int n_active = 0;
+        for (int i = 0; i < n_block; i++) {
+            const int idx = i_start + i;
+            for (int alpha = 0; alpha < 5; alpha++) {
+                q[i][alpha] = tauq_vec[idx][alpha]/tau;
+            }
+            K00[i] = q[i][1]*q[i][1] + q[i][2]*q[i][2] + q[i][3]*q[i][3];
+            M[i]   = sqrt(K00[i]);
+            T00[i] = q[i][0];
+            J0[i]  = q[i][4];
+            iter[i] = 0;
+            use_scalar[i] = (T00[i] < abs_err || T00[i] < M[i]);
+            if (use_scalar[i]) continue;
+
+            v[i] = get_v_guess(T00[i], M[i], grid_pt[idx]->u[0]);
+            active[n_active++] = i;
+        }
+
+        while (n_active > 0) {
+            for (int k = 0; k < n_active; k++) {
+                const int i = active[k];
+                reconst_velocity_fdf(eos_impl, v[i], T00[i], M[i], J0[i],
+                                     fv[i], dfdv[i]);
+            }
+            int n_next = 0;
+            for (int k = 0; k < n_active; k++) {
+                const int i = active[k];
+                iter[i]++;
+                const double v_prev = v[i];
+                const double v_next = std::max(
+                        0.0, std::min(1.0, v_prev - (fv[i]/dfdv[i])));
+                const double rel_error_v = 2.*fv[i]/(v_next + v_prev + 1e-15);
+                v[i] = v_next;
+                if (iter[i] > max_iter) {
+                    use_scalar[i] = true;
+                } else if (fabs(fv[i]) > abs_err
+                           && fabs(rel_error_v) > rel_err) {
+                    active[n_next++] = i;
+                }
+            }
+            n_active = n_next;
+        }
+
+        // the cells that go through ReconstIt_shell are counted there
+        auto *stats = local_stats();
+        for (int i = 0; i < n_block; i++) {
+            const int idx = i_start + i;
+            if (use_scalar[i] || v[i] >= v_critical) {
+                grid_p[idx] = ReconstIt_shell(tau, tauq_vec[idx],
+                                              *grid_pt[idx]);
+                continue;
+            }
+            const double u0 = 1./(sqrt(1. - v[i]*v[i]) + v[i]*abs_err);
+            const double epsilon = T00[i] - v[i]*sqrt(K00[i]);
+            const double rhob = J0[i]/u0;
+            const int flag = set_reconst_cell(eos_impl, grid_p[idx], q[i],
+                                              T00[i], u0, epsilon, rhob,
+                                              *grid_pt[idx]);
+            if (stats != nullptr) {
+                stats->n_cells++;
+                stats->n_iterations += iter[i];
+                if (flag == -1) stats->n_failures++;
+            }
+            if (flag == -1) {
+                revert_grid(grid_p[idx], *grid_pt[idx]);
+            }
+        }
+    }
+}
+
+
 //! This function reverts the grid information back its values
 //! at the previous time step
 void Reconst::revert_grid(ReconstCell &grid_current,
@@ -51,12 +308,40 @@ void Reconst::revert_grid(ReconstCell &grid_current,
     grid_current.u    = grid_prev.u;
 }
 
+int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
+                                       const TJbVec &q,
+                                       const Cell_small &grid_pt,
+                                       const double u0_guess) {
+    switch (eos.get_eos_type()) {
+        case EOSType::ideal_gas:
+            return(ReconstIt_velocity_Newton(eos.get_eos_impl<EOS_idealgas>(),
+                                             grid_p, tau, q, grid_pt,
+                                             u0_guess));
+        case EOSType::single_table:
+            return(ReconstIt_velocity_Newton(eos.get_eos_impl<EOS_hotQCD>(),
+                                             grid_p, tau, q, grid_pt,
+                                             u0_guess));
+        case EOSType::multi_table:
+            return(ReconstIt_velocity_Newton(eos.get_eos_impl<EOS_neos>(),
+                                             grid_p, tau, q, grid_pt,
+                                             u0_guess));
+        default:
+            return(ReconstIt_velocity_Newton(eos.get_eos_impl<EOS_base>(),
+                                             grid_p, tau, q, grid_pt,
+                                             u0_guess));
+    }
+}
+
+
 //! reconstruct TJb from q[0] - q[4]
 //! reconstruct velocity first for finite mu_B case
 //! use Newton's method to solve v and u0
-int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
+template <class EOS_t>
+int Reconst::ReconstIt_velocity_Newton(const EOS_t &eos_impl,
+                                       ReconstCell &grid_p, double tau,
                                        const TJbVec &q,
-                                       const Cell_small &grid_pt) {
+                                       const Cell_small &grid_pt,
+                                       const double u0_guess) {
     double K00 = q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
     double M   = sqrt(K00);
     double T00 = q[0];
@@ -78,14 +363,12 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
         return(-1);
     }
 
-    double u[4], epsilon, pressure, rhob;
+    double u[4], epsilon, rhob;
     
-    double v_guess = sqrt(1. - 1./(grid_pt.u[0]*grid_pt.u[0] + 1e-15));
-    if (v_guess != v_guess) {
-        v_guess = 0.0;
-    }
+    const double v_guess = get_v_guess(T00, M, u0_guess);
     double v_solution = 0.0;
-    int v_status = solve_velocity_Newton(v_guess, T00, M, J0, v_solution);
+    int v_status = solve_velocity_Newton(eos_impl, v_guess, T00, M, J0,
+                                         v_solution);
     if (v_status == 0) {
         return(-1);
     }
@@ -97,7 +380,8 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
     } else {  // for large velocity, solve u0
         double u0_guess = 1./sqrt(1. - v_solution*v_solution);
         double u0_solution = u0_guess;
-        int u0_status = solve_u0_Newton(u0_guess, T00, K00, M, J0, u0_solution);
+        int u0_status = solve_u0_Newton(eos_impl, u0_guess, T00, K00, M, J0,
+                                        u0_solution);
         if (u0_status == 0) {
             return(-1);
         }
@@ -106,6 +390,20 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
         rhob = J0/u0_solution;
     }
 
+    return(set_reconst_cell(eos_impl, grid_p, q, T00, u[0], epsilon, rhob,
+                            grid_pt));
+}
+
+
+//! fills grid_p from the solution u0, epsilon and rhob of the Newton
+//! iterations. returns -1 if u0 changes too much compared to grid_pt
+template <class EOS_t>
+int Reconst::set_reconst_cell(const EOS_t &eos_impl, ReconstCell &grid_p,
+                              const TJbVec &q, const double T00,
+                              const double u0, const double epsilon,
+                              const double rhob, const Cell_small &grid_pt) {
+    double u[4], pressure;
+    u[0] = u0;
     double check_u0_var = std::abs(u[0] - grid_pt.u[0])/grid_pt.u[0];
     if (check_u0_var > 100.) {
         if (grid_pt.epsilon > 1e-6 && echo_level > 2) {
@@ -123,7 +421,7 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
 
     grid_p.e = epsilon;
     grid_p.rhob = rhob;
-    pressure = eos.get_pressure(epsilon, rhob);
+    pressure = eos_impl.get_pressure(epsilon, rhob);
 
     // individual components of velocity
     double velocity_inverse_factor = u[0]/(T00 + pressure);
@@ -159,7 +457,9 @@ void Reconst::regulate_grid(ReconstCell &grid_cell, double elocal) const {
 }
 
 
-int Reconst::solve_velocity_Newton(const double v_guess, const double T00,
+template <class EOS_t>
+int Reconst::solve_velocity_Newton(const EOS_t &eos_impl,
+                                   const double v_guess, const double T00,
                                    const double M, const double J0,
                                    double &v_solution) {
     int v_status      = 1;
@@ -171,7 +471,7 @@ int Reconst::solve_velocity_Newton(const double v_guess, const double T00,
     double fv, dfdv;
     do {
         iter++;
-        reconst_velocity_fdf(v_prev, T00, M, J0, fv, dfdv);
+        reconst_velocity_fdf(eos_impl, v_prev, T00, M, J0, fv, dfdv);
         v_next = v_prev - (fv/dfdv);
         v_next = std::max(0.0, std::min(1.0, v_next));
         abs_error_v = fv;
@@ -184,6 +484,8 @@ int Reconst::solve_velocity_Newton(const double v_guess, const double T00,
     } while (fabs(abs_error_v) > abs_err && fabs(rel_error_v) > rel_err);
 
     v_solution = v_next;
+    auto *stats = local_stats();
+    if (stats != nullptr) stats->n_iterations += iter;
     if (v_status == 0 && echo_level > 5) {
         music_message.warning(
                 "Reconst velocity Newton:: can not find solution!");
@@ -197,7 +499,9 @@ int Reconst::solve_velocity_Newton(const double v_guess, const double T00,
 }
 
 
-int Reconst::solve_u0_Newton(const double u0_guess, const double T00,
+template <class EOS_t>
+int Reconst::solve_u0_Newton(const EOS_t &eos_impl,
+                             const double u0_guess, const double T00,
                              const double K00, const double M, const double J0,
                              double &u0_solution) {
     int u0_status = 1;
@@ -209,7 +513,7 @@ int Reconst::solve_u0_Newton(const double u0_guess, const double T00,
     int iter_u0 = 0;
     do {
         iter_u0++;
-        reconst_u0_fdf(u0_prev, T00, K00, M, J0, fu0, dfdu0);
+        reconst_u0_fdf(eos_impl, u0_prev, T00, K00, M, J0, fu0, dfdu0);
         u0_next = u0_prev - fu0/dfdu0;
         u0_next = std::max(1.0, u0_next);
         abs_error_u0 = fu0;
@@ -222,6 +526,8 @@ int Reconst::solve_u0_Newton(const double u0_guess, const double T00,
     } while (fabs(abs_error_u0) > abs_err && fabs(rel_error_u0) > rel_err);
 
     u0_solution = u0_next;
+    auto *stats = local_stats();
+    if (stats != nullptr) stats->n_iterations += iter_u0;
     if (u0_status == 0 && echo_level > 5) {
         music_message.warning(
                 "Reconst velocity Newton:: can not find solution!");
@@ -237,26 +543,29 @@ int Reconst::solve_u0_Newton(const double u0_guess, const double T00,
 }
 
 
-
-void Reconst::reconst_velocity_fdf(const double v, const double T00,
-                                   const double M, const double J0,
+template <class EOS_t>
+void Reconst::reconst_velocity_fdf(const EOS_t &eos_impl, const double v,
+                                   const double T00, const double M,
+                                   const double J0,
                                    double &fv, double &dfdv) const {
     const double epsilon = T00 - v*M;
     const double temp    = sqrt(1. - v*v);
     const double rho     = J0*temp;
 
-    const double pressure = eos.get_pressure(epsilon, rho);
+    const double pressure = eos_impl.get_pressure(epsilon, rho);
     const double temp1    = T00 + pressure;
     const double temp2    = v/temp;
-    const double dPde     = eos.get_dpde(epsilon, rho);
-    const double dPdrho   = eos.get_dpdrhob(epsilon, rho);
+    const double dPde     = eos_impl.p_e_func(epsilon, rho);
+    const double dPdrho   = eos_impl.p_rho_func(epsilon, rho);
 
     fv   = v - M/temp1;
     dfdv = 1. - M/(temp1*temp1)*(M*dPde + J0*temp2*dPdrho);
 }
 
-void Reconst::reconst_u0_fdf(const double u0, const double T00,
-                             const double K00, const double M, const double J0,
+template <class EOS_t>
+void Reconst::reconst_u0_fdf(const EOS_t &eos_impl, const double u0,
+                             const double T00, const double K00,
+                             const double M, const double J0,
                              double &fu0, double &dfdu0) const {
     const double v       = sqrt(1. - 1./(u0*u0));
     const double epsilon = T00 - v*M;
@@ -265,9 +574,9 @@ void Reconst::reconst_u0_fdf(const double u0, const double T00,
     const double dedu0   = - M/(u0*u0*u0*v + 1e-15);
     const double drhodu0 = - J0/(u0*u0);
 
-    const double pressure = eos.get_pressure(epsilon, rho);
-    const double dPde     = eos.get_dpde(epsilon, rho);
-    const double dPdrho   = eos.get_dpdrhob(epsilon, rho);
+    const double pressure = eos_impl.get_pressure(epsilon, rho);
+    const double dPde     = eos_impl.p_e_func(epsilon, rho);
+    const double dPdrho   = eos_impl.p_rho_func(epsilon, rho);
 
     const double temp1 = (T00 + pressure)*(T00 + pressure) - K00;
     const double denorm1 = sqrt(temp1);
@@ -276,3 +585,65 @@ void Reconst::reconst_u0_fdf(const double u0, const double T00,
     fu0    = u0 - temp;
     dfdu0  = 1. + (dedu0*dPde + drhodu0*dPdrho)*K00/(temp1*denorm1);
 }
+
+
+TEST_CASE("check the batched reconstruction against the scalar one") {
+    // Reconst reads echo_level and reconst_initial_guess
+    InitData DATA{};
+    DATA.echo_level = 0;
+    DATA.reconst_initial_guess = 0;
+    EOS eos(0);
+    Reconst reconst_helper(eos, DATA);
+
+    // random fluid cells, moved a bit to get a non-trivial T^{tau mu}
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    const double tau = 1.3;
+    const int n = 100;
+    std::vector<Cell_small> cells(n);
+    std::vector<const Cell_small*> ref_cells(n);
+    std::vector<TJbVec> tauq(n);
+    for (int i = 0; i < n; i++) {
+        const double e = 1e-4 + 50.*uniform(rng);
+        const double ux = 3.*(uniform(rng) - 0.5);
+        const double uy = 3.*(uniform(rng) - 0.5);
+        const double ueta = 0.5*(uniform(rng) - 0.5);
+        cells[i].epsilon = e;
+        cells[i].rhob = 0.;
+        cells[i].u[1] = ux;
+        cells[i].u[2] = uy;
+        cells[i].u[3] = ueta;
+        cells[i].u[0] = sqrt(1. + ux*ux + uy*uy + ueta*ueta);
+        ref_cells[i] = &cells[i];
+
+        const double e_new = e*(0.8 + 0.4*uniform(rng));
+        const double p_new = eos.get_pressure(e_new, 0.);
+        FlowVec u_new;
+        u_new[1] = ux*(0.8 + 0.4*uniform(rng));
+        u_new[2] = uy*(0.8 + 0.4*uniform(rng));
+        u_new[3] = ueta*(0.8 + 0.4*uniform(rng));
+        u_new[0] = sqrt(1. + u_new[1]*u_new[1] + u_new[2]*u_new[2]
+                        + u_new[3]*u_new[3]);
+        tauq[i][0] = tau*((e_new + p_new)*u_new[0]*u_new[0] - p_new);
+        for (int j = 1; j < 4; j++) {
+            tauq[i][j] = tau*(e_new + p_new)*u_new[0]*u_new[j];
+        }
+        tauq[i][4] = 0.;
+    }
+    // a dilute cell and a cell without solution
+    tauq[7][0] = 1e-12;
+    tauq[11][0] = 0.1*tauq[11][1];
+
+    std::vector<ReconstCell> grid_batch(n);
+    reconst_helper.ReconstIt_shell(tau, n, tauq.data(), ref_cells.data(),
+                                   grid_batch.data());
+    for (int i = 0; i < n; i++) {
+        auto grid_scalar = reconst_helper.ReconstIt_shell(tau, tauq[i],
+                                                          cells[i]);
+        CHECK(grid_batch[i].e == doctest::Approx(grid_scalar.e));
+        CHECK(grid_batch[i].rhob == doctest::Approx(grid_scalar.rhob));
+        for (int mu = 0; mu < 4; mu++) {
+            CHECK(grid_batch[i].u[mu] == doctest::Approx(grid_scalar.u[mu]));
+        }
+    }
+}
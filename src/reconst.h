@@ -4,6 +4,7 @@
 
 #include <array>
 #include <iostream>
+#include <vector>
 #include "util.h"
 #include "data.h"
 #include "cell.h"
@@ -12,6 +13,13 @@
 #include "pretty_ostream.h"
 #include "data_struct.h"
 
+//! counters of the Newton iterations in the reconstruction
+struct ReconstStats {
+    long n_cells      = 0;  //!< number of reconstructed cells
+    long n_iterations = 0;  //!< number of Newton iterations
+    long n_failures   = 0;  //!< number of reverted cells
+};
+
 class Reconst {
  private:
     const EOS &eos;
@@ -28,33 +36,101 @@ class Reconst {
     int echo_level;
     const double v_critical;
 
+    //! 0: the velocity of the reference cell, 1: the velocity extrapolated
+    //! from the previous time steps (if the caller provides it),
+    //! 2: the tabulated solution v(T00, M/T00) at J0 = 0
+    int initial_guess_mode;
+
+    // table of the initial guess v(T00, M/T00) for initial_guess_mode = 2,
+    // uniform in log(T00) and in M/T00
+    int n_guess_T00;
+    int n_guess_M;
+    double guess_log_T00_min;
+    double guess_dlog_T00;
+    double guess_dM;
+    std::vector<double> v_guess_table;
+
+    //! one set of counters per thread, padded to separate cache lines.
+    //! The counters are only kept for echo_level > 5
+    struct alignas(64) PaddedStats {
+        ReconstStats stats;
+    };
+    bool collect_statistics = false;
+    std::vector<PaddedStats> thread_stats;
+    ReconstStats* local_stats();
+
  public:
     Reconst() = default;
     Reconst(const EOS &eos, const InitData &DATA_in);
 
+    //! u0_guess is the initial guess for u^tau with initial_guess_mode = 1;
+    //! u0_guess < 1 means the u^tau of grid_pt
     ReconstCell ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                const Cell_small &grid_pt);
+                                const Cell_small &grid_pt,
+                                double u0_guess = 0.);
+
+    void ReconstIt_shell(double tau, int n, const TJbVec *tauq_vec,
+                         const Cell_small * const *grid_pt,
+                         ReconstCell *grid_p);
 
     void revert_grid(ReconstCell &grid_current,
                      const Cell_small &grid_prev) const;
 
+    //! dispatches once on the EOS family to the specialized solver below
     int ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
-                                  const TJbVec &q, const Cell_small &grid_pt);
-    
-    void reconst_velocity_fdf(const double v, const double T00, const double M,
+                                  const TJbVec &q, const Cell_small &grid_pt,
+                                  double u0_guess);
+
+    int  get_initial_guess_mode() const {return(initial_guess_mode);}
+    double get_v_guess(double T00, double M, double u0_guess) const;
+    void build_v_guess_table();
+
+    //! returns the counters summed over all threads
+    ReconstStats get_statistics() const;
+    void reset_statistics();
+    //! makes room for the counters of every thread of the next parallel
+    //! region, has to be called outside of parallel regions
+    void prepare_statistics();
+
+    // the Newton solvers are instantiated for each concrete EOS class,
+    // so that the EOS calls inside the iterations are not virtual
+    template <class EOS_t>
+    int ReconstIt_velocity_Newton(const EOS_t &eos_impl, ReconstCell &grid_p,
+                                  double tau, const TJbVec &q,
+                                  const Cell_small &grid_pt, double u0_guess);
+
+    template <class EOS_t>
+    void ReconstIt_velocity_Newton_batch(const EOS_t &eos_impl, double tau,
+                                         int n, const TJbVec *tauq_vec,
+                                         const Cell_small * const *grid_pt,
+                                         ReconstCell *grid_p);
+
+    template <class EOS_t>
+    int set_reconst_cell(const EOS_t &eos_impl, ReconstCell &grid_p,
+                         const TJbVec &q, double T00, double u0,
+                         double epsilon, double rhob,
+                         const Cell_small &grid_pt);
+
+    template <class EOS_t>
+    void reconst_velocity_fdf(const EOS_t &eos_impl, const double v,
+                              const double T00, const double M,
                               const double J0, double &fv, double &dfdv) const;
 
-    void reconst_u0_fdf(const double u0, const double T00, const double K00,
+    template <class EOS_t>
+    void reconst_u0_fdf(const EOS_t &eos_impl, const double u0,
+                        const double T00, const double K00,
                         const double M, const double J0,
                         double &fu0, double &dfdu0) const;
 
-    int solve_velocity_Newton(const double v_guess, const double T00,
-                              const double M, const double J0,
-                              double &v_solution);
+    template <class EOS_t>
+    int solve_velocity_Newton(const EOS_t &eos_impl, const double v_guess,
+                              const double T00, const double M,
+                              const double J0, double &v_solution);
 
-    int solve_u0_Newton(const double u0_guess, const double T00,
-                        const double K00, const double M, const double J0,
-                        double &u0_solution);
+    template <class EOS_t>
+    int solve_u0_Newton(const EOS_t &eos_impl, const double u0_guess,
+                        const double T00, const double K00, const double M,
+                        const double J0, double &u0_solution);
 
     void regulate_grid(ReconstCell &grid_cell, double elocal) const;
 };
@@ -0,0 +1,18 @@
+// Copyright @ Bjoern Schenke, Sangyong Jeon, Charles Gale, and Chun Shen
+
+#include "rk_scheme.h"
+
+RKScheme::RKScheme(const int rk_order) {
+    if (rk_order == 1) {
+        alpha_ = {0.};
+        c_     = {0., 1.};
+    } else if (rk_order == 3) {
+        alpha_ = {0., 3./4., 1./3.};
+        c_     = {0., 1., 1./2., 1.};
+    } else {
+        alpha_ = {0., 1./2.};
+        c_     = {0., 1., 1.};
+    }
+    n_stages_ = static_cast<int>(alpha_.size());
+}
+
@@ -0,0 +1,45 @@
+// Copyright @ Bjoern Schenke, Sangyong Jeon, Charles Gale, and Chun Shen
+#ifndef SRC_RK_SCHEME_H_
+#define SRC_RK_SCHEME_H_
+
+#include <vector>
+
+//! Runge-Kutta schemes in the Shu-Osher form. Every stage is a forward
+//! Euler step of the stage state U^(s), combined with the state U^n at
+//! the beginning of the time step,
+//!     U^(s+1) = alpha_s U^n + (1 - alpha_s) (U^(s) + dtau L(U^(s))),
+//! where U^(s) lives at tau + c_s dtau. A stage only reads U^n and U^(s)
+//! and writes U^(s+1), so all schemes run on the three grids of Evolve.
+//!     order 1: forward Euler
+//!     order 2: Heun (SSP-RK2)
+//!     order 3: SSP-RK3 of Shu and Osher
+class RKScheme {
+ private:
+    int n_stages_;
+    std::vector<double> alpha_;
+    //! c_[n_stages_] = 1 is the end of the time step
+    std::vector<double> c_;
+
+ public:
+    explicit RKScheme(int rk_order);
+
+    int get_n_stages() const {return(n_stages_);}
+
+    //! weight of U^n in the result of stage
+    double get_alpha(const int stage) const {return(alpha_[stage]);}
+
+    //! tau of U^(stage); stage = n_stages gives the end of the time step
+    double get_stage_tau(const double tau, const double dtau,
+                         const int stage) const {
+        return(tau + c_[stage]*dtau);
+    }
+
+    //! distance in tau between arena_prev and arena_current at the
+    //! beginning of stage: the previous time step for the first stage, U^n
+    //! and U^(stage) for the others
+    double get_delta_tau_prev(const double dtau, const int stage) const {
+        return(stage == 0 ? dtau : c_[stage]*dtau);
+    }
+};
+
+#endif  // SRC_RK_SCHEME_H_
@@ -3,6 +3,7 @@
 #include <cmath>
 #include "util.h"
 #include "transport_coeffs.h"
+#include "doctest.h"
 
 using Util::hbarc;
 
@@ -10,10 +11,42 @@ TransportCoeffs::TransportCoeffs(const EOS &eosIn, const InitData &Data_in)
     : DATA(Data_in), eos(eosIn) {
     shear_relax_time_factor_ = DATA.shear_relax_time_factor;
     bulk_relax_time_factor_  = DATA.bulk_relax_time_factor;
+    table_T_max_ = 0.;
+    table_inv_dT_ = 0.;
+    if (DATA.transport_coeffs_table == 1) {
+        build_coeff_table();
+    }
+}
+
+
+//! tabulates eta/s(T) and zeta/s(T) up to T = 1 GeV in steps of 0.05 MeV.
+//! The two values of a grid point are stored next to each other, so one
+//! lookup touches a single cache line. Above the table the parametrizations
+//! are evaluated directly.
+void TransportCoeffs::build_coeff_table() {
+    const double dT = 0.05e-3/hbarc;
+    const int n_T = 20000;
+    table_inv_dT_ = 1./dT;
+    table_T_max_ = n_T*dT;
+    coeff_table_.resize(n_T + 1);
+    for (int i = 0; i <= n_T; i++) {
+        const double T = i*dT;
+        coeff_table_[i][0] = compute_eta_over_s(T);
+        coeff_table_[i][1] = compute_zeta_over_s(T);
+    }
+}
+
+
+double TransportCoeffs::interpolate_coeff_table(const double T,
+                                                const int idx) const {
+    const double x = T*table_inv_dT_;
+    const int i = static_cast<int>(x);
+    const double frac = x - i;
+    return((1. - frac)*coeff_table_[i][idx] + frac*coeff_table_[i + 1][idx]);
 }
 
 
-double TransportCoeffs::get_eta_over_s(double T) const {
+double TransportCoeffs::compute_eta_over_s(double T) const {
     double eta_over_s;
     if (DATA.T_dependent_shear_to_s == 1) {
         eta_over_s = get_temperature_dependent_eta_over_s_default(T);
@@ -78,7 +111,7 @@ double TransportCoeffs::get_temperature_dependent_eta_over_s_sims(
 }
 
 
-double TransportCoeffs::get_zeta_over_s(double T) const {
+double TransportCoeffs::compute_zeta_over_s(double T) const {
     double zeta_over_s = 0.;;
     if (DATA.T_dependent_bulk_to_s == 2) {
         zeta_over_s = get_temperature_dependent_zeta_over_s_duke(T);
@@ -186,3 +219,36 @@ double TransportCoeffs::get_temperature_dependent_zeta_over_s_default(
 }
 
 
+
+
+TEST_CASE("check the tabulated transport coefficients") {
+    InitData DATA;
+    DATA.shear_relax_time_factor = 5.;
+    DATA.bulk_relax_time_factor = 1./14.55;
+    DATA.shear_to_s = 0.08;
+    DATA.T_dependent_shear_to_s = 0;
+    DATA.zeta_over_s_max = 0.13;
+    DATA.zeta_over_s_width_in_GeV = 0.08;
+    DATA.zeta_over_s_T_peak_in_GeV = 0.16;
+    DATA.zeta_over_s_lambda_asymm = -0.2;
+    DATA.eta_over_s_T_kink_in_GeV = 0.16;
+    DATA.eta_over_s_low_T_slope_in_GeV = -0.5;
+    DATA.eta_over_s_high_T_slope_in_GeV = 0.8;
+    DATA.eta_over_s_at_kink = 0.1;
+    DATA.T_dependent_bulk_to_s = 3;
+    DATA.transport_coeffs_table = 1;
+    EOS eos(0);
+    TransportCoeffs transport_coeffs(eos, DATA);
+
+    for (int i = 0; i < 1000; i++) {
+        const double T = (0.1 + 0.4*i/1000.)/hbarc;
+        CHECK(transport_coeffs.get_eta_over_s(T)
+              == doctest::Approx(transport_coeffs.compute_eta_over_s(T)));
+        CHECK(transport_coeffs.get_zeta_over_s(T)
+              == doctest::Approx(transport_coeffs.compute_zeta_over_s(T)));
+    }
+    // above the table
+    const double T = 1.5/hbarc;
+    CHECK(transport_coeffs.get_zeta_over_s(T)
+          == transport_coeffs.compute_zeta_over_s(T));
+}
@@ -2,6 +2,8 @@
 #ifndef SRC_TRANSPORT_H_
 #define SRC_TRANSPORT_H_
 
+#include <array>
+#include <vector>
 #include "data.h"
 #include "eos.h"
 
@@ -12,11 +14,33 @@ class TransportCoeffs {
     double shear_relax_time_factor_;
     double bulk_relax_time_factor_;
 
+    //! {eta/s, zeta/s} on a uniform grid in T starting at T = 0,
+    //! empty if the parametrizations are evaluated directly
+    std::vector<std::array<double, 2>> coeff_table_;
+    double table_T_max_;
+    double table_inv_dT_;
+
+    void build_coeff_table();
+    double interpolate_coeff_table(double T, int idx) const;
+
  public:
     TransportCoeffs(const EOS &eosIn, const InitData &DATA_in);
 
-    double get_eta_over_s(double T) const;
-    double get_zeta_over_s(double T) const;
+    double get_eta_over_s(double T) const {
+        if (!coeff_table_.empty() && T >= 0. && T < table_T_max_)
+            return(interpolate_coeff_table(T, 0));
+        return(compute_eta_over_s(T));
+    }
+    double get_zeta_over_s(double T) const {
+        if (!coeff_table_.empty() && T >= 0. && T < table_T_max_)
+            return(interpolate_coeff_table(T, 1));
+        return(compute_zeta_over_s(T));
+    }
+
+    //! the parametrizations selected by T_dependent_Shear_to_S_ratio and
+    //! T_dependent_Bulk_to_S_ratio, without the table
+    double compute_eta_over_s(double T) const;
+    double compute_zeta_over_s(double T) const;
 
     double get_temperature_dependent_eta_over_s_default(double T) const;
     double get_temperature_dependent_zeta_over_s_default(double T) const;
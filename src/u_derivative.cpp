@@ -14,14 +14,17 @@ U_derivative::U_derivative(const InitData &DATA_in, const EOS &eosIn) :
 }
 
 //! This function is a shell function to calculate parital^\nu u^\mu
-void U_derivative::MakedU(double tau, SCGrid &arena_prev, SCGrid &arena_current,
+//! delta_tau_prev is the distance in tau between arena_prev and arena_current
+void U_derivative::MakedU(double tau, double delta_tau_prev,
+                          SCGrid &arena_prev, SCGrid &arena_current,
                           int ix, int iy, int ieta) {
     dUsup = {0.0};
 
     // this calculates du/dx, du/dy, (du/deta)/tau
     MakeDSpatial(tau, arena_current, ix, iy, ieta);
     // this calculates du/dtau
-    MakeDTau(tau, &arena_prev(ix, iy, ieta), &arena_current(ix, iy, ieta));
+    MakeDTau(tau, delta_tau_prev,
+             &arena_prev(ix, iy, ieta), &arena_current(ix, iy, ieta));
 }
 
 
@@ -139,11 +142,10 @@ int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
 
     // calculate dUsup[m][n] = partial_n u_m
     Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
+        double slope[3];
+        minmod.minmod_dx(&p1.u[1], &c.u[1], &m1.u[1], slope, 3);
         for (int m = 1; m <= 3; m++) {
-            const double f   = c.u[m];
-            const double fp1 = p1.u[m];
-            const double fm1 = m1.u[m];
-            const double g   = minmod.minmod_dx(fp1, f, fm1) / delta[direction];
+            const double g   = slope[m - 1] / delta[direction];
             dUsup[m][direction] = g;
         }
     });
@@ -184,14 +186,14 @@ int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
     return 1;
 }/* MakeDSpatial */
 
-int U_derivative::MakeDTau(double tau,
+int U_derivative::MakeDTau(double tau, double delta_tau_prev,
                            Cell_small *grid_pt_prev, Cell_small *grid_pt) {
     /* this makes dU[m][0] = partial^tau u^m */
     /* note the minus sign at the end because of g[0][0] = -1 */
     double f;
     for (int m = 1; m < 4; m++) {
         /* first order is more stable */
-        f = (grid_pt->u[m] - grid_pt_prev->u[m])/DATA.delta_tau;
+        f = (grid_pt->u[m] - grid_pt_prev->u[m])/delta_tau_prev;
         dUsup[m][0] = -f;  // g00 = -1
     }
 
@@ -223,7 +225,7 @@ int U_derivative::MakeDTau(double tau,
     muB          = eos.get_muB(eps, rhob);
     T            = eos.get_temperature(eps, rhob);
     tildemu_prev = muB/T;
-    f            = (tildemu - tildemu_prev)/(DATA.delta_tau);
+    f            = (tildemu - tildemu_prev)/delta_tau_prev;
     dUsup[m][0]  = -f;  // g00 = -1
     return 1;
 }
@@ -18,7 +18,8 @@ class U_derivative {
 
  public:
     U_derivative(const InitData &DATA_in, const EOS &eosIn);
-    void MakedU(double tau, SCGrid &arena_prev, SCGrid &arena_current,
+    void MakedU(double tau, double delta_tau_prev,
+                SCGrid &arena_prev, SCGrid &arena_current,
                 int ix, int iy, int ieta);
 
     //! this function returns the expansion rate on the grid
@@ -37,7 +38,8 @@ class U_derivative {
         double tau, SCGrid &arena, int ieta, int ix, int iy,
         DumuVec &a_local, VelocityShearVec &sigma);
     int MakeDSpatial(double tau, SCGrid &arena, int ix, int iy, int ieta);
-    int MakeDTau(double tau, Cell_small *grid_pt_prev, Cell_small *grid_pt);
+    int MakeDTau(double tau, double delta_tau_prev,
+                 Cell_small *grid_pt_prev, Cell_small *grid_pt);
 };
 
 #endif
@@ -2,6 +2,7 @@
 // Copyright (C) 2017  Gabriel Denicol, Charles Gale, Sangyong Jeon, Matthew Luzum, Jean-François Paquet, Björn Schenke, Chun Shen
 
 #include "util.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <execinfo.h>
@@ -66,10 +67,10 @@ int IsFile(string file_name) {
 
 // support comments in the parameters file
 // comments need to start with #
-string StringFind4(string file_name, string str_in) {
-    string inputname = file_name;
-    string str = str_in;
-
+//! This function reads the "name value" pairs of a parameter file in the
+//! order of the file. Everything after a # is a comment, and the file ends
+//! at the line EndOfData
+std::vector<std::pair<string, string>> ReadParameterFile(string file_name) {
     string tmpfilename;
     tmpfilename = "input.default";
     
@@ -91,40 +92,36 @@ string StringFind4(string file_name, string str_in) {
     }/* if isfile */
   
     // pass checking, now read in the parameter file
+    std::vector<std::pair<string, string>> parameters;
     string temp_string;
-    std::ifstream input(inputname.c_str());
-    getline(input, temp_string);  // read in the first entry
-
-    int ind = 0;
-    string para_name;
-    string para_val;
-    while (temp_string.compare("EndOfData") != 0) {
-        // check whether it is the end of the file
+    std::ifstream input(file_name.c_str());
+    while (getline(input, temp_string)
+           && temp_string.compare("EndOfData") != 0) {
         string para_string;
         std::stringstream temp_ss(temp_string);
         getline(temp_ss, para_string, '#');  // remove the comments
         if (para_string.compare("") != 0
                 && para_string.find_first_not_of(' ') != std::string::npos) {
             // check the read in string is not empty
+            string para_name;
+            string para_val;
             std::stringstream para_stream(para_string);
             para_stream >> para_name >> para_val;
-            if (para_name.compare(str) == 0) {
-                // find the desired parameter
-                ind++;
-                input.close();
-                return(para_val);
-            }  /* if right, return */
+            if (para_name != "")
+                parameters.push_back(std::make_pair(para_name, para_val));
         }
-        getline(input, temp_string);  // read in the next entry
     }/* while */
     input.close(); // finish read in and close the file
-    
-    // the desired parameter is not in the parameter file, then return "empty"
-    if (ind == 0) {
-        return("empty");
+    return(parameters);
+}/* ReadParameterFile */
+
+
+//! This function returns the value of the first occurrence of the
+//! parameter str_in in the file, or "empty" if it is not there
+string StringFind4(string file_name, string str_in) {
+    for (const auto &parameter : ReadParameterFile(file_name)) {
+        if (parameter.first == str_in) return(parameter.second);
     }
-    // should not cross here !!!
-    std::cout << "Error in StringFind4 !!!\n";
     return("empty");
 }/* StringFind4 */
 
@@ -291,4 +288,12 @@ Mat4x4 UnpackVecToMatrix(const ViscousVec &in_vector) {
     return out_matrix;
   }
 
+#ifdef MUSIC_MIXED_PRECISION
+Mat4x4 UnpackVecToMatrix(const ViscousStorageVec &in_vector) {
+    ViscousVec vec_double;
+    std::copy(in_vector.begin(), in_vector.end(), vec_double.begin());
+    return(UnpackVecToMatrix(vec_double));
+}
+#endif
+
 }
@@ -11,6 +11,8 @@
 #include <fstream>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 #include <sys/stat.h>
 #include "data_struct.h"
 
@@ -30,6 +32,8 @@ namespace Util {
 
     int IsFile(std::string);
 
+    std::vector<std::pair<std::string, std::string>> ReadParameterFile(
+                                                    std::string file_name);
     std::string StringFind4(std::string file_name, std::string str_in);
 
     double lin_int(double x1,double x2,double f1,double f2,double x);
@@ -46,6 +50,9 @@ namespace Util {
 
     Mat4x4 UnpackVecToMatrix(const Arr10 &in_vector);
     Mat4x4 UnpackVecToMatrix(const ViscousVec &in_vector);
+#ifdef MUSIC_MIXED_PRECISION
+    Mat4x4 UnpackVecToMatrix(const ViscousStorageVec &in_vector);
+#endif
 
     // check whether a weak pointer is initialized or not
     template <typename T>
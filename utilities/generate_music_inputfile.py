@@ -74,6 +74,7 @@ hydro_dict.update({
 
     'output_hydro_debug_info': 0,           # flag to output additional evolution information for debuging
     'store_hydro_info_in_memory': 0,        # flag to store hydro information in memory
+    'store_hydro_info_precision': 4,        # bytes per stored value: 4 (float) or 2 (half)
     'output_evolution_data': 0,             # flag to output evolution history to file
     'output_movie_flag': 0,                 # flag to output evolution file for making movie
     'output_evolution_T_cut': 0.145,        # minimum temperature for outputing fluid cells [GeV]